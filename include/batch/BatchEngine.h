@@ -0,0 +1,251 @@
+/**************************************************************************************************
+ * Implementation of the TAD BatchEngine
+ **************************************************************************************************/
+
+#ifndef BATCHENGINE_H
+#define BATCHENGINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../maze/QueryMaze.h"
+#include "../perf/perf.h"
+#include "../tree/Tree.h"
+
+using namespace std;
+
+// Consulta de caminho entre dois nós do labirinto
+struct BatchQuery
+{
+    int startId;
+    int goalId;
+    SearchAlgorithm algorithm;
+};
+
+// Resultado de uma consulta; pathLength conta os nós do caminho (0 se não achou)
+struct BatchResult
+{
+    bool found;
+    int pathLength;
+    int statesNumber;
+    int visitedStatesNumber;
+    double elapsedTime; // Segundos
+};
+
+// Executa um lote de consultas sobre o mesmo labirinto com um número fixo de threads.
+//
+// O labirinto é só lido; cada thread tem a sua árvore com o seu SearchContext, reaproveitados
+// de uma consulta para a outra. As threads pegam a próxima consulta com um contador atômico e
+// gravam o resultado na posição da consulta, então não há nenhuma trava compartilhada.
+template <class Maze>
+class BatchEngine
+{
+
+private:
+    Maze *maze;
+    int threadCount;
+    OpenListType openListType;
+    vector<BatchQuery> queries;
+    vector<BatchResult> results;
+    atomic<size_t> nextQuery;
+    double elapsedTime;
+
+    void work();
+
+public:
+    BatchEngine(Maze *maze, int threadCount);
+    ~BatchEngine();
+
+    // Operations
+    void addQuery(int startId, int goalId, SearchAlgorithm algorithm);
+    void addRandomQueries(int count, SearchAlgorithm algorithm, unsigned long long seed);
+    void run();
+
+    // Getters
+    int getThreadCount();
+    OpenListType getOpenListType();
+    int getQueryCount();
+    BatchQuery &getQuery(int index);
+    BatchResult &getResult(int index);
+    int getFoundCount();
+    double getElapsedTime();
+    double getQueriesPerSecond();
+    double getLatencyPercentile(double percentile);
+
+    // Setters
+    void setOpenListType(OpenListType openListType);
+};
+
+// Construtor: threadCount <= 0 usa uma thread por núcleo
+template <class Maze>
+BatchEngine<Maze>::BatchEngine(Maze *maze, int threadCount)
+{
+    this->maze = maze;
+    this->threadCount = threadCount;
+    if (this->threadCount <= 0)
+        this->threadCount = max(1, (int)thread::hardware_concurrency());
+    this->openListType = AUTOMATIC_OPEN_LIST;
+    this->nextQuery = 0;
+    this->elapsedTime = 0;
+}
+
+// Destrutor
+template <class Maze>
+BatchEngine<Maze>::~BatchEngine()
+{
+    this->maze = nullptr;
+}
+
+template <class Maze>
+void BatchEngine<Maze>::addQuery(int startId, int goalId, SearchAlgorithm algorithm)
+{
+    this->queries.push_back({startId, goalId, algorithm});
+}
+
+// Pares de início e objetivo sorteados entre todos os nós, reproduzíveis pela semente
+template <class Maze>
+void BatchEngine<Maze>::addRandomQueries(int count, SearchAlgorithm algorithm, unsigned long long seed)
+{
+    int nodeCount = this->maze->getNodeCount();
+    if (nodeCount <= 0)
+        return;
+
+    mt19937_64 rng(seed);
+    this->queries.reserve(this->queries.size() + count);
+    for (int i = 0; i < count; i++)
+    {
+        int startId = (int)(rng() % nodeCount);
+        int goalId = (int)(rng() % nodeCount);
+        this->addQuery(startId, goalId, algorithm);
+    }
+}
+
+// Laço de cada thread: pega consultas até o lote acabar
+template <class Maze>
+void BatchEngine<Maze>::work()
+{
+    Tree tree;
+    tree.setOpenListType(this->openListType);
+    Perf::PerformanceTimer clock;
+
+    while (true)
+    {
+        size_t index = this->nextQuery.fetch_add(1, memory_order_relaxed);
+        if (index >= this->queries.size())
+            break;
+
+        BatchQuery &query = this->queries[index];
+        QueryMaze<Maze> queryMaze(this->maze, query.startId, query.goalId);
+
+        clock.start();
+        stack<int> solution = tree.search(query.algorithm, &queryMaze);
+        clock.stop();
+
+        BatchResult &result = this->results[index];
+        result.found = !solution.empty();
+        result.pathLength = (int)solution.size();
+        result.statesNumber = tree.getStatesNumber();
+        result.visitedStatesNumber = tree.getVisitedStatesNumber();
+        result.elapsedTime = clock.elapsed_time();
+    }
+}
+
+template <class Maze>
+void BatchEngine<Maze>::run()
+{
+    this->results.assign(this->queries.size(), BatchResult());
+    this->nextQuery = 0;
+
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    vector<thread> workers;
+    for (int i = 0; i < this->threadCount; i++)
+        workers.emplace_back(&BatchEngine<Maze>::work, this);
+    for (thread &worker : workers)
+        worker.join();
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+}
+
+// Getters
+template <class Maze>
+int BatchEngine<Maze>::getThreadCount()
+{
+    return this->threadCount;
+}
+
+template <class Maze>
+OpenListType BatchEngine<Maze>::getOpenListType()
+{
+    return this->openListType;
+}
+
+template <class Maze>
+int BatchEngine<Maze>::getQueryCount()
+{
+    return (int)this->queries.size();
+}
+
+template <class Maze>
+BatchQuery &BatchEngine<Maze>::getQuery(int index)
+{
+    return this->queries[index];
+}
+
+template <class Maze>
+BatchResult &BatchEngine<Maze>::getResult(int index)
+{
+    return this->results[index];
+}
+
+template <class Maze>
+int BatchEngine<Maze>::getFoundCount()
+{
+    int found = 0;
+    for (BatchResult &result : this->results)
+        found += result.found;
+    return found;
+}
+
+template <class Maze>
+double BatchEngine<Maze>::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+template <class Maze>
+double BatchEngine<Maze>::getQueriesPerSecond()
+{
+    return this->elapsedTime > 0 ? this->results.size() / this->elapsedTime : 0;
+}
+
+// Latência (segundos) abaixo da qual fica a fração percentile das consultas, ex.: 0.99
+template <class Maze>
+double BatchEngine<Maze>::getLatencyPercentile(double percentile)
+{
+    if (this->results.empty())
+        return 0;
+
+    vector<double> latencies;
+    latencies.reserve(this->results.size());
+    for (BatchResult &result : this->results)
+        latencies.push_back(result.elapsedTime);
+
+    size_t rank = (size_t)(percentile * (latencies.size() - 1) + 0.5);
+    nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+    return latencies[rank];
+}
+
+// Setters
+template <class Maze>
+void BatchEngine<Maze>::setOpenListType(OpenListType openListType)
+{
+    this->openListType = openListType;
+}
+
+#endif // BATCHENGINE_H
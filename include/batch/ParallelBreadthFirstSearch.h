@@ -0,0 +1,457 @@
+/**************************************************************************************************
+ * Implementation of the TAD ParallelBreadthFirstSearch
+ **************************************************************************************************/
+
+#ifndef PARALLELBREADTHFIRSTSEARCH_H
+#define PARALLELBREADTHFIRSTSEARCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <vector>
+
+#include "../maze/Edge.h"
+#include "../perf/perf.h"
+
+using namespace std;
+
+// Busca em largura a partir de um nó até todos os nós alcançáveis, nível a nível e dividida
+// entre threads. Cada nível é expandido de um de dois jeitos (direction-optimizing BFS):
+//
+//   de cima para baixo -- a fronteira é uma lista; cada thread pega blocos dela, gera os
+//                         vizinhos e guarda os novos nós no seu próprio buffer;
+//   de baixo para cima -- a fronteira é um bitmap; cada thread percorre blocos de nós ainda
+//                         não alcançados e procura um vizinho na fronteira.
+//
+// O segundo só compensa quando a fronteira é uma fração grande dos nós que faltam, então a
+// troca é feita pelo tamanho da fronteira. Níveis pequenos de cima para baixo rodam só na
+// thread que chamou run(), sem acordar as outras.
+//
+// O pai de cada nó é o vizinho de menor id no nível anterior, em qualquer dos dois modos, então
+// distâncias e pais são os mesmos para qualquer número de threads (com 1 thread é a busca
+// serial). O labirinto deve ser não direcionado, como Graph, GridMaze e MappedGraph.
+template <class Maze>
+class ParallelBreadthFirstSearch
+{
+
+private:
+    static const int BLOCK_SIZE = 1024;         // Nós (ou palavras do bitmap) por bloco
+    static const int PARALLEL_THRESHOLD = 4096; // Fronteira mínima para dividir um nível
+    static const int BOTTOM_UP_ALPHA = 14;      // Troca para baixo para cima se fronteira > faltam / alfa
+    static const int TOP_DOWN_BETA = 24;        // Volta para cima para baixo se fronteira < nós / beta
+
+    Maze *maze;
+    int threadCount;
+    int nodeCount;
+    unique_ptr<atomic<int>[]> distances; // Nível de cada nó, -1 se não alcançado
+    unique_ptr<atomic<int>[]> parents;   // Vizinho de menor id no nível anterior, -1 na origem
+
+    vector<int> frontier;                // Fronteira de cima para baixo
+    vector<vector<int>> nextFrontiers;   // Próxima fronteira, um buffer por thread
+    vector<uint64_t> frontierBits;       // Fronteira de baixo para cima
+    vector<uint64_t> nextFrontierBits;
+    vector<int> nextCounts;              // Nós alcançados no nível por cada thread
+
+    // Pool de threads, mantido durante run()
+    vector<thread> workers;
+    mutex poolMutex;
+    condition_variable workReady;
+    condition_variable workDone;
+    uint64_t jobGeneration;
+    int pendingWorkers;
+    bool bottomUpJob;
+    bool stopping;
+    atomic<size_t> nextBlock;
+    int currentLevel;
+
+    int reachedCount;
+    int levelCount;
+    int bottomUpLevelCount;
+    double elapsedTime;
+
+    void work(int worker);
+    void runLevel(bool bottomUp);
+    void expandTopDown(int worker);
+    void expandBottomUp(int worker);
+    void claim(int mazeNodeId, int parentId, int worker);
+
+public:
+    ParallelBreadthFirstSearch(Maze *maze, int threadCount);
+    ~ParallelBreadthFirstSearch();
+
+    // Operations
+    void run(int startId);
+
+    // Getters
+    int getThreadCount();
+    int getDistance(int id);
+    int getParent(int id);
+    stack<int> getPath(int goalId);
+    int getReachedCount();
+    int getLevelCount();
+    int getBottomUpLevelCount();
+    double getElapsedTime();
+};
+
+// Construtor: threadCount <= 0 usa uma thread por núcleo
+template <class Maze>
+ParallelBreadthFirstSearch<Maze>::ParallelBreadthFirstSearch(Maze *maze, int threadCount)
+{
+    this->maze = maze;
+    this->threadCount = threadCount;
+    if (this->threadCount <= 0)
+        this->threadCount = max(1, (int)thread::hardware_concurrency());
+    this->nodeCount = 0;
+    this->jobGeneration = 0;
+    this->pendingWorkers = 0;
+    this->bottomUpJob = false;
+    this->stopping = false;
+    this->nextBlock = 0;
+    this->currentLevel = 0;
+    this->reachedCount = 0;
+    this->levelCount = 0;
+    this->bottomUpLevelCount = 0;
+    this->elapsedTime = 0;
+}
+
+// Destrutor
+template <class Maze>
+ParallelBreadthFirstSearch<Maze>::~ParallelBreadthFirstSearch()
+{
+    this->maze = nullptr;
+}
+
+// Marca o nó como alcançado no próximo nível; se outro nó da fronteira já o marcou, fica o pai
+// de menor id
+template <class Maze>
+void ParallelBreadthFirstSearch<Maze>::claim(int mazeNodeId, int parentId, int worker)
+{
+    int nextLevel = this->currentLevel + 1;
+    int distance = -1;
+    if (this->distances[mazeNodeId].compare_exchange_strong(distance, nextLevel, memory_order_relaxed))
+        this->nextFrontiers[worker].push_back(mazeNodeId);
+    else if (distance != nextLevel)
+        return;
+
+    int parent = this->parents[mazeNodeId].load(memory_order_relaxed);
+    while ((parent < 0 || parentId < parent) &&
+           !this->parents[mazeNodeId].compare_exchange_weak(parent, parentId, memory_order_relaxed))
+        ;
+}
+
+template <class Maze>
+void ParallelBreadthFirstSearch<Maze>::expandTopDown(int worker)
+{
+    Edge edges[4];
+    size_t frontierSize = this->frontier.size();
+
+    while (true)
+    {
+        size_t begin = this->nextBlock.fetch_add(BLOCK_SIZE, memory_order_relaxed);
+        if (begin >= frontierSize)
+            break;
+        size_t end = min(frontierSize, begin + BLOCK_SIZE);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            int mazeNodeId = this->frontier[i];
+            int numEdges = this->maze->getEdges(mazeNodeId, edges);
+            for (int e = 0; e < numEdges; e++)
+            {
+                int targetId = edges[e].getTargetId();
+                int distance = this->distances[targetId].load(memory_order_relaxed);
+                if (distance < 0 || distance == this->currentLevel + 1)
+                    this->claim(targetId, mazeNodeId, worker);
+            }
+        }
+    }
+}
+
+// Cada bloco é um intervalo de palavras do bitmap, então cada palavra da próxima fronteira só
+// é escrita por uma thread
+template <class Maze>
+void ParallelBreadthFirstSearch<Maze>::expandBottomUp(int worker)
+{
+    Edge edges[4];
+    size_t wordCount = this->frontierBits.size();
+    int nextLevel = this->currentLevel + 1;
+
+    while (true)
+    {
+        size_t begin = this->nextBlock.fetch_add(BLOCK_SIZE, memory_order_relaxed);
+        if (begin >= wordCount)
+            break;
+        size_t end = min(wordCount, begin + BLOCK_SIZE);
+
+        for (size_t word = begin; word < end; word++)
+        {
+            uint64_t bits = 0;
+            int last = min(this->nodeCount, (int)(word * 64 + 64));
+            for (int mazeNodeId = (int)(word * 64); mazeNodeId < last; mazeNodeId++)
+            {
+                if (this->distances[mazeNodeId].load(memory_order_relaxed) >= 0)
+                    continue;
+
+                int parentId = -1;
+                int numEdges = this->maze->getEdges(mazeNodeId, edges);
+                for (int e = 0; e < numEdges; e++)
+                {
+                    int targetId = edges[e].getTargetId();
+                    if (((this->frontierBits[targetId >> 6] >> (targetId & 63)) & 1) &&
+                        (parentId < 0 || targetId < parentId))
+                        parentId = targetId;
+                }
+
+                if (parentId >= 0)
+                {
+                    this->distances[mazeNodeId].store(nextLevel, memory_order_relaxed);
+                    this->parents[mazeNodeId].store(parentId, memory_order_relaxed);
+                    bits |= (uint64_t)1 << (mazeNodeId & 63);
+                    this->nextCounts[worker]++;
+                }
+            }
+            this->nextFrontierBits[word] = bits;
+        }
+    }
+}
+
+// Laço das threads auxiliares: esperam um nível, expandem a sua parte e avisam que acabaram
+template <class Maze>
+void ParallelBreadthFirstSearch<Maze>::work(int worker)
+{
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        bool bottomUp;
+        {
+            unique_lock<mutex> lock(this->poolMutex);
+            this->workReady.wait(lock, [&]
+                                 { return this->stopping || this->jobGeneration != seenGeneration; });
+            if (this->stopping)
+                return;
+            seenGeneration = this->jobGeneration;
+            bottomUp = this->bottomUpJob;
+        }
+
+        if (bottomUp)
+            this->expandBottomUp(worker);
+        else
+            this->expandTopDown(worker);
+
+        {
+            lock_guard<mutex> lock(this->poolMutex);
+            if (--this->pendingWorkers == 0)
+                this->workDone.notify_one();
+        }
+    }
+}
+
+// Expande um nível; a thread que chamou run() é a de índice 0 e também trabalha
+template <class Maze>
+void ParallelBreadthFirstSearch<Maze>::runLevel(bool bottomUp)
+{
+    this->nextBlock = 0;
+
+    bool parallel = !this->workers.empty() && (bottomUp || (int)this->frontier.size() >= PARALLEL_THRESHOLD);
+    if (parallel)
+    {
+        lock_guard<mutex> lock(this->poolMutex);
+        this->bottomUpJob = bottomUp;
+        this->pendingWorkers = (int)this->workers.size();
+        this->jobGeneration++;
+        this->workReady.notify_all();
+    }
+
+    if (bottomUp)
+        this->expandBottomUp(0);
+    else
+        this->expandTopDown(0);
+
+    if (parallel)
+    {
+        unique_lock<mutex> lock(this->poolMutex);
+        this->workDone.wait(lock, [&]
+                            { return this->pendingWorkers == 0; });
+    }
+}
+
+template <class Maze>
+void ParallelBreadthFirstSearch<Maze>::run(int startId)
+{
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    this->nodeCount = this->maze->getNodeCount();
+    this->reachedCount = 0;
+    this->levelCount = 0;
+    this->bottomUpLevelCount = 0;
+
+    this->distances.reset(new atomic<int>[this->nodeCount]);
+    this->parents.reset(new atomic<int>[this->nodeCount]);
+    for (int id = 0; id < this->nodeCount; id++)
+    {
+        this->distances[id].store(-1, memory_order_relaxed);
+        this->parents[id].store(-1, memory_order_relaxed);
+    }
+
+    if (startId < 0 || startId >= this->nodeCount)
+    {
+        clock.stop();
+        this->elapsedTime = clock.elapsed_time();
+        return;
+    }
+
+    // A primeira chamada de getEdges termina de montar o labirinto (Graph::finalize) antes que
+    // as threads comecem a lê-lo
+    Edge edges[4];
+    this->maze->getEdges(startId, edges);
+
+    this->distances[startId].store(0, memory_order_relaxed);
+    this->frontier.assign(1, startId);
+    this->nextFrontiers.assign(this->threadCount, vector<int>());
+    this->nextCounts.assign(this->threadCount, 0);
+    size_t wordCount = ((size_t)this->nodeCount + 63) / 64;
+
+    this->stopping = false;
+    for (int worker = 1; worker < this->threadCount; worker++)
+        this->workers.emplace_back(&ParallelBreadthFirstSearch<Maze>::work, this, worker);
+
+    bool bottomUp = false;
+    int frontierCount = 1;
+    int previousFrontierCount = 0;
+    long long unvisitedCount = this->nodeCount - 1;
+    this->reachedCount = 1;
+
+    while (frontierCount > 0)
+    {
+        // Troca de modo pelo tamanho da fronteira, convertendo a fronteira de formato. Só volta
+        // para cima para baixo com a fronteira encolhendo, senão o modo poderia alternar a cada nível
+        if (!bottomUp && frontierCount > unvisitedCount / BOTTOM_UP_ALPHA)
+        {
+            bottomUp = true;
+            this->frontierBits.assign(wordCount, 0);
+            for (int mazeNodeId : this->frontier)
+                this->frontierBits[mazeNodeId >> 6] |= (uint64_t)1 << (mazeNodeId & 63);
+            this->nextFrontierBits.assign(wordCount, 0);
+        }
+        else if (bottomUp && frontierCount < this->nodeCount / TOP_DOWN_BETA && frontierCount < previousFrontierCount)
+        {
+            bottomUp = false;
+            this->frontier.clear();
+            for (size_t word = 0; word < wordCount; word++)
+                for (uint64_t bits = this->frontierBits[word]; bits != 0; bits &= bits - 1)
+                    this->frontier.push_back((int)(word * 64 + __builtin_ctzll(bits)));
+        }
+
+        for (int worker = 0; worker < this->threadCount; worker++)
+        {
+            this->nextFrontiers[worker].clear();
+            this->nextCounts[worker] = 0;
+        }
+
+        previousFrontierCount = frontierCount;
+        this->runLevel(bottomUp);
+
+        if (bottomUp)
+        {
+            this->frontierBits.swap(this->nextFrontierBits);
+            frontierCount = 0;
+            for (int count : this->nextCounts)
+                frontierCount += count;
+            this->bottomUpLevelCount++;
+        }
+        else
+        {
+            this->frontier.clear();
+            for (vector<int> &next : this->nextFrontiers)
+                this->frontier.insert(this->frontier.end(), next.begin(), next.end());
+            frontierCount = (int)this->frontier.size();
+        }
+
+        this->currentLevel++;
+        this->levelCount++;
+        this->reachedCount += frontierCount;
+        unvisitedCount -= frontierCount;
+    }
+
+    {
+        lock_guard<mutex> lock(this->poolMutex);
+        this->stopping = true;
+        this->workReady.notify_all();
+    }
+    for (thread &worker : this->workers)
+        worker.join();
+    this->workers.clear();
+
+    // O último nível expandido não alcançou ninguém
+    this->levelCount--;
+    this->currentLevel = 0;
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+}
+
+// Getters
+template <class Maze>
+int ParallelBreadthFirstSearch<Maze>::getThreadCount()
+{
+    return this->threadCount;
+}
+
+// Número de arestas até a origem, -1 se o nó não é alcançável
+template <class Maze>
+int ParallelBreadthFirstSearch<Maze>::getDistance(int id)
+{
+    return this->distances[id].load(memory_order_relaxed);
+}
+
+template <class Maze>
+int ParallelBreadthFirstSearch<Maze>::getParent(int id)
+{
+    return this->parents[id].load(memory_order_relaxed);
+}
+
+// Caminho da origem até o nó pelos pais, com a origem no topo (vazio se não alcançável)
+template <class Maze>
+stack<int> ParallelBreadthFirstSearch<Maze>::getPath(int goalId)
+{
+    stack<int> pilha;
+    if (this->getDistance(goalId) < 0)
+        return pilha;
+
+    for (int id = goalId; id >= 0; id = this->getParent(id))
+        pilha.push(id);
+    return pilha;
+}
+
+template <class Maze>
+int ParallelBreadthFirstSearch<Maze>::getReachedCount()
+{
+    return this->reachedCount;
+}
+
+// Maior distância a partir da origem
+template <class Maze>
+int ParallelBreadthFirstSearch<Maze>::getLevelCount()
+{
+    return this->levelCount;
+}
+
+template <class Maze>
+int ParallelBreadthFirstSearch<Maze>::getBottomUpLevelCount()
+{
+    return this->bottomUpLevelCount;
+}
+
+template <class Maze>
+double ParallelBreadthFirstSearch<Maze>::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+#endif // PARALLELBREADTHFIRSTSEARCH_H
@@ -0,0 +1,609 @@
+/**************************************************************************************************
+ * Implementation of the TAD ContractionHierarchy
+ **************************************************************************************************/
+
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stack>
+#include <vector>
+
+#include "Edge.h"
+#include "../perf/perf.h"
+#include "../tree/IndexedHeap.h"
+#include "../tree/SearchContext.h"
+
+using namespace std;
+
+// Formato binário da hierarquia: cabeçalho seguido dos vetores, na ordem abaixo
+//
+//   ranks       int32  [nós]       posição de cada nó na ordem de contração
+//   edgeOffsets uint32 [nós + 1]   arestas para cima do nó i em [edgeOffsets[i], edgeOffsets[i + 1])
+//   targets     int32  [arestas]
+//   weights     double [arestas]
+//   middles     int32  [arestas]   nó contraído que o atalho pula, -1 nas arestas do labirinto
+//
+// mazeEdgeCount e mazeHash identificam o labirinto de origem (arestas, destinos e pesos), para
+// a hierarquia não ser usada em outro labirinto com o mesmo número de nós
+struct ContractionHierarchyHeader
+{
+    char magic[8]; // "MAZECH"
+    uint32_t version;
+    uint32_t reserved;
+    int64_t nodeCount;
+    int64_t edgeCount;
+    int64_t shortcutCount;
+    int64_t mazeEdgeCount;
+    uint64_t mazeHash;
+};
+
+const char CONTRACTION_HIERARCHY_MAGIC[8] = "MAZECH";
+const uint32_t CONTRACTION_HIERARCHY_VERSION = 2;
+
+// Hierarquia de contração para consultas repetidas de menor caminho em um labirinto que não
+// muda. O pré-processamento contrai os nós um a um, do menos para o mais importante: ao tirar
+// um nó, cada par de vizinhos cujo menor caminho passava por ele ganha um atalho. A ordem vem
+// de um heap com a diferença de arestas (atalhos criados menos arestas removidas) mais o
+// número de vizinhos já contraídos, reavaliada quando o nó sai do heap.
+//
+// Sobra um grafo "para cima": cada nó guarda só as arestas para nós contraídos depois dele.
+// A consulta é um Dijkstra bidirecional que só sobe, do início e do objetivo, e os atalhos
+// do caminho são desfeitos recursivamente até as arestas do labirinto. O labirinto precisa
+// ser não direcionado com pesos não negativos.
+class ContractionHierarchy
+{
+
+private:
+    // Aresta durante o pré-processamento
+    struct Arc
+    {
+        int target;
+        double weight;
+        int middle;
+    };
+
+    // Hierarquia pronta
+    vector<int> ranks;
+    vector<uint32_t> edgeOffsets;
+    vector<int> targets;
+    vector<double> weights;
+    vector<int> middles;
+    int64_t shortcutCount;
+    int64_t mazeEdgeCount;
+    uint64_t mazeHash;
+    double elapsedTime;
+
+    // Pré-processamento
+    vector<vector<Arc>> arcs;
+    vector<uint8_t> contracted;
+    vector<int> contractedNeighbours;
+    SearchContext witnessContext;
+    IndexedHeap witnessHeap;
+
+    // Consulta
+    SearchContext contexts[2];
+    IndexedHeap heaps[2];
+    double distance;
+    int settledCount;
+
+    static const int WITNESS_SETTLE_LIMIT = 64; // Nós fechados por busca de testemunha
+
+    void addArc(int sourceId, int targetId, double weight, int middle);
+    void witnessSearch(int sourceId, int skipId, double maxCost);
+    int contractNode(int id, bool simulate);
+    double getPriority(int id);
+    void unpackEdge(int fromId, int toId, vector<int> &path);
+    void clear();
+    template <class Maze>
+    static uint64_t hashMaze(Maze *maze, int64_t &edgeCount);
+
+public:
+    ContractionHierarchy();
+    ~ContractionHierarchy();
+
+    // Operations
+    template <class Maze>
+    void build(Maze *maze);
+    bool save(const char *path);
+    template <class Maze>
+    bool load(const char *path, Maze *maze);
+    stack<int> findPath(int startId, int goalId);
+
+    // Getters
+    int getNodeCount();
+    int getEdgeCount();
+    int64_t getShortcutCount();
+    size_t getMemoryUsage();
+    double getElapsedTime();
+    double getDistance();
+    int getSettledCount();
+};
+
+// Construtor
+ContractionHierarchy::ContractionHierarchy()
+{
+    this->shortcutCount = 0;
+    this->mazeEdgeCount = 0;
+    this->mazeHash = 0;
+    this->elapsedTime = 0;
+    this->distance = numeric_limits<double>::infinity();
+    this->settledCount = 0;
+    this->edgeOffsets.push_back(0);
+}
+
+// Destrutor
+ContractionHierarchy::~ContractionHierarchy()
+{
+    this->shortcutCount = 0;
+}
+
+// Insere ou encurta a aresta sourceId -> targetId (há no máximo uma entre cada par)
+void ContractionHierarchy::addArc(int sourceId, int targetId, double weight, int middle)
+{
+    for (Arc &arc : this->arcs[sourceId])
+    {
+        if (arc.target == targetId)
+        {
+            if (weight < arc.weight)
+            {
+                arc.weight = weight;
+                arc.middle = middle;
+            }
+            return;
+        }
+    }
+    this->arcs[sourceId].push_back({targetId, weight, middle});
+}
+
+// Dijkstra limitado a partir de sourceId entre os nós ainda não contraídos, sem passar por
+// skipId. Para em maxCost ou depois de WITNESS_SETTLE_LIMIT nós: um caminho não encontrado
+// só gera um atalho a mais, nunca um caminho errado
+void ContractionHierarchy::witnessSearch(int sourceId, int skipId, double maxCost)
+{
+    int nodeCount = (int)this->arcs.size();
+    this->witnessContext.reset(nodeCount);
+    this->witnessHeap.reset(nodeCount);
+
+    this->witnessContext.setReached(sourceId, 0, -1);
+    this->witnessHeap.push(sourceId, 0, 0);
+
+    for (int settled = 0; !this->witnessHeap.isEmpty() && settled < WITNESS_SETTLE_LIMIT; settled++)
+    {
+        if (this->witnessHeap.getMinPriority() > maxCost)
+            break;
+
+        int id, value;
+        this->witnessHeap.pop(id, value);
+        double cost = this->witnessContext.getCost(id);
+
+        for (Arc &arc : this->arcs[id])
+        {
+            if (arc.target == skipId || this->contracted[arc.target])
+                continue;
+
+            double newCost = cost + arc.weight;
+            if (newCost >= this->witnessContext.getCost(arc.target))
+                continue;
+
+            bool open = this->witnessHeap.contains(arc.target);
+            this->witnessContext.setReached(arc.target, newCost, id);
+            if (open)
+                this->witnessHeap.decrease(arc.target, newCost, 0);
+            else
+                this->witnessHeap.push(arc.target, newCost, 0);
+        }
+    }
+}
+
+// Conta (simulate) ou cria os atalhos necessários para contrair o nó
+int ContractionHierarchy::contractNode(int id, bool simulate)
+{
+    // Vizinhos ainda não contraídos; as arestas para nós contraídos são descartadas aqui
+    vector<Arc> &nodeArcs = this->arcs[id];
+    nodeArcs.erase(remove_if(nodeArcs.begin(), nodeArcs.end(),
+                             [this](const Arc &arc) { return this->contracted[arc.target] != 0; }),
+                   nodeArcs.end());
+
+    double maxWeight = 0;
+    for (Arc &arc : nodeArcs)
+        maxWeight = max(maxWeight, arc.weight);
+
+    int shortcuts = 0;
+    for (size_t i = 0; i + 1 < nodeArcs.size(); i++)
+    {
+        this->witnessSearch(nodeArcs[i].target, id, nodeArcs[i].weight + maxWeight);
+
+        for (size_t j = i + 1; j < nodeArcs.size(); j++)
+        {
+            double viaCost = nodeArcs[i].weight + nodeArcs[j].weight;
+            if (this->witnessContext.getCost(nodeArcs[j].target) <= viaCost)
+                continue;
+
+            shortcuts++;
+            if (!simulate)
+            {
+                this->addArc(nodeArcs[i].target, nodeArcs[j].target, viaCost, id);
+                this->addArc(nodeArcs[j].target, nodeArcs[i].target, viaCost, id);
+            }
+        }
+    }
+    return shortcuts;
+}
+
+// Diferença de arestas mais vizinhos já contraídos (espalha a contração pelo labirinto)
+double ContractionHierarchy::getPriority(int id)
+{
+    int shortcuts = this->contractNode(id, true);
+    return shortcuts - (int)this->arcs[id].size() + this->contractedNeighbours[id];
+}
+
+template <class Maze>
+void ContractionHierarchy::build(Maze *maze)
+{
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    int nodeCount = maze->getNodeCount();
+    this->arcs.assign(nodeCount, vector<Arc>());
+    this->contracted.assign(nodeCount, 0);
+    this->contractedNeighbours.assign(nodeCount, 0);
+    this->ranks.assign(nodeCount, -1);
+    this->shortcutCount = 0;
+    this->mazeHash = hashMaze(maze, this->mazeEdgeCount);
+
+    Edge edges[4];
+    for (int id = 0; id < nodeCount; id++)
+    {
+        int numEdges = maze->getEdges(id, edges);
+        for (int i = 0; i < numEdges; i++)
+            if (edges[i].getTargetId() != id)
+                this->addArc(id, edges[i].getTargetId(), edges[i].getWeight(), -1);
+    }
+
+    IndexedHeap order;
+    order.reset(nodeCount);
+    for (int id = 0; id < nodeCount; id++)
+        order.push(id, this->getPriority(id), 0);
+
+    // Arestas para cima de cada nó, fixadas quando ele é contraído
+    vector<vector<Arc>> upward(nodeCount);
+
+    for (int rank = 0; rank < nodeCount; rank++)
+    {
+        int id, value;
+        order.pop(id, value);
+
+        // Reavaliação preguiçosa: se a prioridade subiu, o nó volta para o heap
+        double priority = this->getPriority(id);
+        if (!order.isEmpty() && priority > order.getMinPriority())
+        {
+            order.push(id, priority, 0);
+            rank--;
+            continue;
+        }
+
+        this->shortcutCount += this->contractNode(id, false);
+        this->contracted[id] = 1;
+        this->ranks[id] = rank;
+        upward[id] = this->arcs[id];
+
+        for (Arc &arc : upward[id])
+        {
+            this->contractedNeighbours[arc.target]++;
+            double neighbourPriority = this->getPriority(arc.target);
+            if (neighbourPriority < order.getPriority(arc.target))
+                order.decrease(arc.target, neighbourPriority, 0);
+        }
+
+        vector<Arc>().swap(this->arcs[id]);
+    }
+
+    this->edgeOffsets.assign(1, 0);
+    this->targets.clear();
+    this->weights.clear();
+    this->middles.clear();
+    for (int id = 0; id < nodeCount; id++)
+    {
+        for (Arc &arc : upward[id])
+        {
+            this->targets.push_back(arc.target);
+            this->weights.push_back(arc.weight);
+            this->middles.push_back(arc.middle);
+        }
+        this->edgeOffsets.push_back((uint32_t)this->targets.size());
+    }
+
+    vector<vector<Arc>>().swap(this->arcs);
+    vector<uint8_t>().swap(this->contracted);
+    vector<int>().swap(this->contractedNeighbours);
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+}
+
+// Grava a hierarquia no formato binário
+bool ContractionHierarchy::save(const char *path)
+{
+    ofstream output(path, ios::binary | ios::trunc);
+    if (!output.is_open())
+        return false;
+
+    ContractionHierarchyHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CONTRACTION_HIERARCHY_MAGIC, 8);
+    header.version = CONTRACTION_HIERARCHY_VERSION;
+    header.nodeCount = this->getNodeCount();
+    header.edgeCount = this->getEdgeCount();
+    header.shortcutCount = this->shortcutCount;
+    header.mazeEdgeCount = this->mazeEdgeCount;
+    header.mazeHash = this->mazeHash;
+
+    output.write((const char *)&header, sizeof(header));
+    output.write((const char *)this->ranks.data(), this->ranks.size() * sizeof(int));
+    output.write((const char *)this->edgeOffsets.data(), this->edgeOffsets.size() * sizeof(uint32_t));
+    output.write((const char *)this->targets.data(), this->targets.size() * sizeof(int));
+    output.write((const char *)this->weights.data(), this->weights.size() * sizeof(double));
+    output.write((const char *)this->middles.data(), this->middles.size() * sizeof(int));
+
+    return output.good();
+}
+
+// FNV-1a do número de arestas, dos destinos e dos pesos de cada nó, na ordem de getEdges
+template <class Maze>
+uint64_t ContractionHierarchy::hashMaze(Maze *maze, int64_t &edgeCount)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](uint64_t value)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 0x100000001B3ULL;
+        }
+    };
+
+    edgeCount = 0;
+    Edge edges[4];
+    for (int id = 0; id < maze->getNodeCount(); id++)
+    {
+        int numEdges = maze->getEdges(id, edges);
+        mix((uint64_t)numEdges);
+        for (int i = 0; i < numEdges; i++)
+        {
+            double weight = edges[i].getWeight();
+            uint64_t weightBits;
+            memcpy(&weightBits, &weight, sizeof(weightBits));
+            mix((uint64_t)(uint32_t)edges[i].getTargetId());
+            mix(weightBits);
+        }
+        edgeCount += numEdges;
+    }
+    return hash;
+}
+
+void ContractionHierarchy::clear()
+{
+    this->ranks.clear();
+    this->edgeOffsets.assign(1, 0);
+    this->targets.clear();
+    this->weights.clear();
+    this->middles.clear();
+    this->shortcutCount = 0;
+    this->mazeEdgeCount = 0;
+    this->mazeHash = 0;
+}
+
+// Lê uma hierarquia gravada por save; devolve false se o arquivo não for uma hierarquia válida
+// ou tiver sido montada para outro labirinto. Os deslocamentos e os nós das arestas são
+// conferidos, porque a consulta indexa os vetores com eles
+template <class Maze>
+bool ContractionHierarchy::load(const char *path, Maze *maze)
+{
+    ifstream input(path, ios::binary);
+    if (!input.is_open())
+        return false;
+
+    ContractionHierarchyHeader header;
+    if (!input.read((char *)&header, sizeof(header)) ||
+        memcmp(header.magic, CONTRACTION_HIERARCHY_MAGIC, 8) != 0 || header.version != CONTRACTION_HIERARCHY_VERSION ||
+        header.nodeCount != maze->getNodeCount() || header.edgeCount < 0 || header.edgeCount > (int64_t)UINT32_MAX)
+        return false;
+
+    int64_t mazeEdgeCount;
+    uint64_t mazeHash = hashMaze(maze, mazeEdgeCount);
+    if (header.mazeEdgeCount != mazeEdgeCount || header.mazeHash != mazeHash)
+        return false;
+
+    this->ranks.resize(header.nodeCount);
+    this->edgeOffsets.resize(header.nodeCount + 1);
+    this->targets.resize(header.edgeCount);
+    this->weights.resize(header.edgeCount);
+    this->middles.resize(header.edgeCount);
+
+    input.read((char *)this->ranks.data(), this->ranks.size() * sizeof(int));
+    input.read((char *)this->edgeOffsets.data(), this->edgeOffsets.size() * sizeof(uint32_t));
+    input.read((char *)this->targets.data(), this->targets.size() * sizeof(int));
+    input.read((char *)this->weights.data(), this->weights.size() * sizeof(double));
+    input.read((char *)this->middles.data(), this->middles.size() * sizeof(int));
+
+    bool valid = input && this->edgeOffsets[0] == 0 && this->edgeOffsets[header.nodeCount] == (uint32_t)header.edgeCount;
+    for (int64_t id = 0; valid && id < header.nodeCount; id++)
+        valid = this->edgeOffsets[id] <= this->edgeOffsets[id + 1];
+    for (int64_t e = 0; valid && e < header.edgeCount; e++)
+        valid = this->targets[e] >= 0 && this->targets[e] < header.nodeCount &&
+                this->middles[e] >= -1 && this->middles[e] < header.nodeCount;
+    if (!valid)
+    {
+        this->clear();
+        return false;
+    }
+
+    this->shortcutCount = header.shortcutCount;
+    this->mazeEdgeCount = mazeEdgeCount;
+    this->mazeHash = mazeHash;
+    this->elapsedTime = 0;
+    return true;
+}
+
+// Acrescenta ao caminho os nós da aresta fromId -> toId sem o primeiro, desfazendo os atalhos
+void ContractionHierarchy::unpackEdge(int fromId, int toId, vector<int> &path)
+{
+    vector<pair<int, int>> pending(1, {fromId, toId});
+
+    while (!pending.empty())
+    {
+        int a = pending.back().first;
+        int b = pending.back().second;
+        pending.pop_back();
+
+        // A aresta fica guardada no nó de menor posição, apontando para cima
+        int lower = this->ranks[a] < this->ranks[b] ? a : b;
+        int higher = lower == a ? b : a;
+        int middle = -1;
+        for (uint32_t e = this->edgeOffsets[lower]; e < this->edgeOffsets[lower + 1]; e++)
+        {
+            if (this->targets[e] == higher)
+            {
+                middle = this->middles[e];
+                break;
+            }
+        }
+
+        if (middle < 0)
+            path.push_back(b);
+        else
+        {
+            pending.push_back({middle, b});
+            pending.push_back({a, middle});
+        }
+    }
+}
+
+// Menor caminho entre startId e goalId, com o início no topo (vazio se não houver)
+stack<int> ContractionHierarchy::findPath(int startId, int goalId)
+{
+    stack<int> pilha;
+    int nodeCount = this->getNodeCount();
+    this->distance = numeric_limits<double>::infinity();
+    this->settledCount = 0;
+
+    int roots[2] = {startId, goalId};
+    for (int side = 0; side < 2; side++)
+    {
+        this->contexts[side].reset(nodeCount);
+        this->heaps[side].reset(nodeCount);
+        this->contexts[side].setReached(roots[side], 0, -1);
+        this->heaps[side].push(roots[side], 0, 0);
+    }
+
+    int meetingId = startId == goalId ? startId : -1;
+    if (meetingId >= 0)
+        this->distance = 0;
+
+    // Cada lado sobe até o seu menor aberto não poder mais melhorar o melhor encontro
+    while (true)
+    {
+        bool open[2];
+        for (int side = 0; side < 2; side++)
+            open[side] = !this->heaps[side].isEmpty() && this->heaps[side].getMinPriority() < this->distance;
+        if (!open[0] && !open[1])
+            break;
+
+        int side = !open[1] || (open[0] && this->heaps[0].getMinPriority() <= this->heaps[1].getMinPriority()) ? 0 : 1;
+        SearchContext &context = this->contexts[side];
+        SearchContext &otherContext = this->contexts[1 - side];
+
+        int id, value;
+        this->heaps[side].pop(id, value);
+        context.setClosed(id);
+        this->settledCount++;
+
+        double cost = context.getCost(id);
+        if (otherContext.isReached(id) && cost + otherContext.getCost(id) < this->distance)
+        {
+            this->distance = cost + otherContext.getCost(id);
+            meetingId = id;
+        }
+
+        for (uint32_t e = this->edgeOffsets[id]; e < this->edgeOffsets[id + 1]; e++)
+        {
+            int targetId = this->targets[e];
+            double newCost = cost + this->weights[e];
+            if (newCost >= context.getCost(targetId))
+                continue;
+
+            bool inHeap = this->heaps[side].contains(targetId);
+            context.setReached(targetId, newCost, id);
+            if (inHeap)
+                this->heaps[side].decrease(targetId, newCost, 0);
+            else
+                this->heaps[side].push(targetId, newCost, 0);
+        }
+    }
+
+    if (meetingId < 0)
+        return pilha;
+
+    // Início -> encontro pelos pais da subida do início, encontro -> objetivo pelos do objetivo
+    vector<int> upPath;
+    for (int id = meetingId; id >= 0; id = this->contexts[0].getParent(id))
+        upPath.push_back(id);
+
+    vector<int> path(1, startId);
+    for (int i = (int)upPath.size() - 1; i > 0; i--)
+        this->unpackEdge(upPath[i], upPath[i - 1], path);
+    for (int id = meetingId; this->contexts[1].getParent(id) >= 0; id = this->contexts[1].getParent(id))
+        this->unpackEdge(id, this->contexts[1].getParent(id), path);
+
+    for (int i = (int)path.size() - 1; i >= 0; i--)
+        pilha.push(path[i]);
+    return pilha;
+}
+
+// Getters
+int ContractionHierarchy::getNodeCount()
+{
+    return (int)this->ranks.size();
+}
+
+int ContractionHierarchy::getEdgeCount()
+{
+    return (int)this->targets.size();
+}
+
+int64_t ContractionHierarchy::getShortcutCount()
+{
+    return this->shortcutCount;
+}
+
+// Bytes dos vetores da hierarquia (o que save grava, sem o cabeçalho)
+size_t ContractionHierarchy::getMemoryUsage()
+{
+    return this->ranks.size() * sizeof(int) + this->edgeOffsets.size() * sizeof(uint32_t) +
+           this->targets.size() * (sizeof(int) + sizeof(double) + sizeof(int));
+}
+
+// Tempo do pré-processamento, em segundos (0 se a hierarquia foi lida de um arquivo)
+double ContractionHierarchy::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+// Custo do caminho da última consulta, infinito se não houver caminho
+double ContractionHierarchy::getDistance()
+{
+    return this->distance;
+}
+
+// Nós fechados pelas duas subidas da última consulta
+int ContractionHierarchy::getSettledCount()
+{
+    return this->settledCount;
+}
+
+#endif // CONTRACTIONHIERARCHY_H
@@ -0,0 +1,307 @@
+/**************************************************************************************************
+ * Implementation of the TAD CorridorMaze
+ **************************************************************************************************/
+
+#ifndef CORRIDORMAZE_H
+#define CORRIDORMAZE_H
+
+#include <algorithm>
+#include <climits>
+#include <stack>
+#include <vector>
+
+#include "Edge.h"
+#include "../perf/perf.h"
+
+using namespace std;
+
+// Labirinto reduzido: só ficam os nós que não estão no meio de um corredor (cruzamentos, becos
+// sem saída, início e objetivo), e cada corredor -- uma sequência de nós com exatamente duas
+// passagens -- vira uma única aresta com a soma dos pesos e a direção do primeiro passo.
+//
+// Os nós do reduzido têm ids próprios, de 0 a getNodeCount() - 1; getCellId dá o nó do
+// labirinto original. As buscas rodam sobre o reduzido e expandPath refaz o caminho nó a nó
+// no original, andando de novo pelos corredores. O labirinto original precisa ser não
+// direcionado e não pode mudar depois da redução.
+template <class Maze>
+class CorridorMaze
+{
+
+private:
+    Maze *maze;
+    vector<int> cellIds;     // Nó original de cada nó do reduzido
+    vector<int> reducedIds;  // Nó do reduzido de cada nó original, -1 se ele está em um corredor
+    vector<Edge> edges;      // Corredores agrupados por nó de origem (CSR, como no Graph)
+    vector<int> edgeOffsets; // Corredores do nó i ficam em [edgeOffsets[i], edgeOffsets[i + 1])
+    vector<int> firstCellIds; // Primeiro nó original de cada corredor, para refazê-lo no expandPath
+    int maxIntegerWeight;    // Maior corredor se os pesos forem inteiros não negativos, senão -1
+    unsigned long long version; // Versão do original quando o reduzido foi montado
+    double elapsedTime;
+
+    int walkCorridor(int previousId, int cellId, double &weight, vector<int> *cells);
+
+public:
+    CorridorMaze(Maze *maze);
+    ~CorridorMaze();
+
+    // Getters
+    int getCellCount();
+    int getCellId(int id);
+    int getReducedId(int cellId);
+    int getEdgeCount();
+    double getElapsedTime();
+    int getX(int id);
+    int getY(int id);
+
+    // Interface usada pelas buscas da árvore
+    int getNodeCount();
+    int getStartId();
+    int getGoalId();
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    bool isUniformGrid();
+    unsigned long long getVersion();
+
+    // Caminho de nós do reduzido (início no topo) para o caminho nó a nó no original
+    stack<int> expandPath(stack<int> path);
+};
+
+// Construtor: monta o reduzido em duas passadas pelo labirinto
+template <class Maze>
+CorridorMaze<Maze>::CorridorMaze(Maze *maze)
+{
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    this->maze = maze;
+    this->version = maze->getVersion();
+    this->maxIntegerWeight = maze->getMaxIntegerWeight() >= 0 ? 0 : -1;
+
+    int cellCount = maze->getNodeCount();
+    int startId = maze->getStartId();
+    int goalId = maze->getGoalId();
+    this->reducedIds.assign(cellCount, -1);
+
+    // Primeira passada: nós que ficam
+    Edge cellEdges[4];
+    for (int cellId = 0; cellId < cellCount; cellId++)
+    {
+        if (maze->getEdges(cellId, cellEdges) != 2 || cellId == startId || cellId == goalId)
+        {
+            this->reducedIds[cellId] = (int)this->cellIds.size();
+            this->cellIds.push_back(cellId);
+        }
+    }
+
+    // Segunda passada: um corredor por passagem de cada nó que ficou
+    this->edgeOffsets.reserve(this->cellIds.size() + 1);
+    for (int id = 0; id < (int)this->cellIds.size(); id++)
+    {
+        this->edgeOffsets.push_back((int)this->edges.size());
+
+        int cellId = this->cellIds[id];
+        int numEdges = maze->getEdges(cellId, cellEdges);
+        for (int i = 0; i < numEdges; i++)
+        {
+            double weight = cellEdges[i].getWeight();
+            int targetId = this->walkCorridor(cellId, cellEdges[i].getTargetId(), weight, nullptr);
+            if (targetId < 0)
+                continue;
+
+            Edge edge(id, this->reducedIds[targetId], 0);
+            edge.setDirection(cellEdges[i].getDirection());
+            edge.setWeight(weight);
+            this->edges.push_back(edge);
+            this->firstCellIds.push_back(cellEdges[i].getTargetId());
+
+            if (this->maxIntegerWeight >= 0)
+                this->maxIntegerWeight = weight > INT_MAX ? -1 : max(this->maxIntegerWeight, (int)weight);
+        }
+    }
+    this->edgeOffsets.push_back((int)this->edges.size());
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+}
+
+// Destrutor
+template <class Maze>
+CorridorMaze<Maze>::~CorridorMaze()
+{
+    this->maze = nullptr;
+}
+
+// Anda pelo corredor que entra em cellId vindo de previousId até um nó que ficou no reduzido,
+// somando os pesos em weight e guardando os nós do meio em cells. Devolve -1 em um ciclo só de
+// corredor (nenhum nó do ciclo ficou, então ele não é alcançável pelo reduzido)
+template <class Maze>
+int CorridorMaze<Maze>::walkCorridor(int previousId, int cellId, double &weight, vector<int> *cells)
+{
+    Edge cellEdges[4];
+    for (int steps = (int)this->reducedIds.size(); steps > 0; steps--)
+    {
+        if (this->reducedIds[cellId] >= 0)
+            return cellId;
+
+        if (cells != nullptr)
+            cells->push_back(cellId);
+
+        // Nó de corredor: exatamente duas passagens, segue pela que não é a de volta
+        this->maze->getEdges(cellId, cellEdges);
+        int next = cellEdges[0].getTargetId() != previousId ? 0 : 1;
+        weight += cellEdges[next].getWeight();
+        previousId = cellId;
+        cellId = cellEdges[next].getTargetId();
+    }
+    return -1;
+}
+
+// Getters
+template <class Maze>
+int CorridorMaze<Maze>::getCellCount()
+{
+    return (int)this->reducedIds.size();
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getCellId(int id)
+{
+    return this->cellIds[id];
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getReducedId(int cellId)
+{
+    return this->reducedIds[cellId];
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getEdgeCount()
+{
+    return (int)this->edges.size();
+}
+
+// Tempo gasto na redução, em segundos
+template <class Maze>
+double CorridorMaze<Maze>::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getX(int id)
+{
+    return this->maze->getX(this->cellIds[id]);
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getY(int id)
+{
+    return this->maze->getY(this->cellIds[id]);
+}
+
+// Interface de busca
+
+template <class Maze>
+int CorridorMaze<Maze>::getNodeCount()
+{
+    return (int)this->cellIds.size();
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getStartId()
+{
+    int startId = this->maze->getStartId();
+    return startId >= 0 ? this->reducedIds[startId] : -1;
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getGoalId()
+{
+    int goalId = this->maze->getGoalId();
+    return goalId >= 0 ? this->reducedIds[goalId] : -1;
+}
+
+template <class Maze>
+bool CorridorMaze<Maze>::isFinal(int id)
+{
+    return this->maze->isFinal(this->cellIds[id]);
+}
+
+template <class Maze>
+double CorridorMaze<Maze>::getHeuristic(int id)
+{
+    return this->maze->getHeuristic(this->cellIds[id]);
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getEdges(int id, Edge edges[4])
+{
+    int begin = this->edgeOffsets[id];
+    int count = min(4, this->edgeOffsets[id + 1] - begin);
+    for (int i = 0; i < count; i++)
+        edges[i] = this->edges[begin + i];
+    return count;
+}
+
+template <class Maze>
+int CorridorMaze<Maze>::getMaxIntegerWeight()
+{
+    return this->maxIntegerWeight;
+}
+
+// Cada corredor vira uma aresta com o comprimento dele, então o reduzido nunca é uma grade
+template <class Maze>
+bool CorridorMaze<Maze>::isUniformGrid()
+{
+    return false;
+}
+
+// O reduzido não muda depois de montado, então fica com a versão do original naquele momento
+template <class Maze>
+unsigned long long CorridorMaze<Maze>::getVersion()
+{
+    return this->version;
+}
+
+// Entre dois nós seguidos do caminho usa o corredor mais curto que os liga, refazendo os nós
+// do meio a partir do primeiro nó do corredor (a direção não basta: nas listas de arestas ela
+// pode ser -1 ou se repetir no nó). Devolve vazio se dois nós seguidos não têm corredor
+template <class Maze>
+stack<int> CorridorMaze<Maze>::expandPath(stack<int> path)
+{
+    vector<int> cells;
+    vector<int> corridor;
+
+    while (!path.empty())
+    {
+        int id = path.top();
+        path.pop();
+        cells.push_back(this->cellIds[id]);
+        if (path.empty())
+            break;
+
+        int nextId = path.top();
+        int bestEdge = -1;
+        for (int e = this->edgeOffsets[id]; e < this->edgeOffsets[id + 1]; e++)
+            if (this->edges[e].getTargetId() == nextId &&
+                (bestEdge < 0 || this->edges[e].getWeight() < this->edges[bestEdge].getWeight()))
+                bestEdge = e;
+        if (bestEdge < 0)
+            return stack<int>();
+
+        double weight = 0;
+        corridor.clear();
+        this->walkCorridor(this->cellIds[id], this->firstCellIds[bestEdge], weight, &corridor);
+        cells.insert(cells.end(), corridor.begin(), corridor.end());
+    }
+
+    stack<int> expanded;
+    for (int i = (int)cells.size() - 1; i >= 0; i--)
+        expanded.push(cells[i]);
+    return expanded;
+}
+
+#endif // CORRIDORMAZE_H
@@ -16,10 +16,11 @@ private:
     int sourceId; //Id do nó de origem
     int targetId;   //Id do nó destino
     int direction;  //Cima, baixo, esquerda ou direita
-    Edge *nextEdge; // Ponteiro para pŕoxima aresta
+    Edge *nextEdge; // Ponteiro para a próxima aresta do mesmo nó (vizinha no vetor CSR)
     double weight;
 
 public:
+    Edge();
     Edge(int sourceId, int targetId, int weight);
     ~Edge();
 
@@ -29,6 +30,7 @@ public:
     Edge *getNextEdge();
     int getDirection();
     double getWeight();
+    bool isValid();
 
     // Setters
     void setNextEdge(Edge *edge);
@@ -36,6 +38,16 @@ public:
     void setWeight(double weight);
 };
 
+// Construtor de uma regra vazia (sem aresta)
+Edge::Edge()
+{
+    this->sourceId = -1;
+    this->targetId = -1;
+    this->nextEdge = nullptr;
+    this->direction = -1;
+    this->weight = -1;
+}
+
 // Construtor
 Edge::Edge(int sourceId, int targetId, int weight)
 {
@@ -62,6 +74,7 @@ int Edge::getTargetId() { return this->targetId; }
 Edge *Edge::getNextEdge() { return this->nextEdge; }
 int Edge::getDirection() { return this->direction; }
 double Edge::getWeight() { return this->weight; }
+bool Edge::isValid() { return this->targetId >= 0; }
 
 
 // Setters
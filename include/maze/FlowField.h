@@ -0,0 +1,190 @@
+/**************************************************************************************************
+ * Implementation of the TAD FlowField
+ **************************************************************************************************/
+
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <cmath>
+#include <cstdint>
+#include <stack>
+#include <vector>
+
+#include "Edge.h"
+#include "../perf/perf.h"
+#include "../tree/IndexedHeap.h"
+
+using namespace std;
+
+const uint8_t NO_NEXT_HOP = 0xFF;
+
+// Campo de fluxo até um objetivo: um Dijkstra ao contrário, a partir do objetivo, guarda para
+// cada nó a distância até ele e a direção do próximo passo. Qualquer início segue as direções
+// até o objetivo, sem busca, em tempo proporcional ao caminho. Serve para muitos agentes indo
+// para a mesma saída; o labirinto precisa ser não direcionado.
+//
+// O campo guarda a versão do labirinto em que foi calculado (getVersion), para quem o
+// reaproveita saber quando ele ficou velho.
+class FlowField
+{
+
+private:
+    int goalId;
+    unsigned long long version;
+    vector<float> distances;  // Distância até o objetivo, infinito se não alcança
+    vector<uint8_t> nextHops; // Direção da aresta do próximo passo, NO_NEXT_HOP no objetivo e sem caminho
+    double elapsedTime;
+
+public:
+    FlowField();
+    ~FlowField();
+
+    // Operations
+    template <class Maze>
+    void build(Maze *maze, int goalId);
+    template <class Maze>
+    stack<int> followPath(Maze *maze, int startId);
+
+    // Getters
+    int getGoalId();
+    unsigned long long getVersion();
+    double getDistance(int id);
+    int getNextHop(int id);
+    size_t getMemoryUsage();
+    double getElapsedTime();
+};
+
+// Construtor
+FlowField::FlowField()
+{
+    this->goalId = -1;
+    this->version = 0;
+    this->elapsedTime = 0;
+}
+
+// Destrutor
+FlowField::~FlowField()
+{
+    this->goalId = -1;
+}
+
+// O valor de cada entrada do heap é o vizinho pelo qual o nó foi alcançado; quando o nó é
+// fechado, a aresta até esse vizinho vira o próximo passo
+template <class Maze>
+void FlowField::build(Maze *maze, int goalId)
+{
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    int nodeCount = maze->getNodeCount();
+    this->goalId = goalId;
+    this->version = maze->getVersion();
+    this->distances.assign(nodeCount, INFINITY);
+    this->nextHops.assign(nodeCount, NO_NEXT_HOP);
+
+    IndexedHeap openList;
+    openList.reset(nodeCount);
+    this->distances[goalId] = 0;
+    openList.push(goalId, 0, -1);
+
+    Edge edges[4];
+    while (!openList.isEmpty())
+    {
+        int id, towardGoalId;
+        openList.pop(id, towardGoalId);
+
+        int numEdges = maze->getEdges(id, edges);
+        double distance = this->distances[id];
+        for (int i = 0; i < numEdges; i++)
+        {
+            int targetId = edges[i].getTargetId();
+            if (targetId == towardGoalId && this->nextHops[id] == NO_NEXT_HOP)
+                this->nextHops[id] = (uint8_t)edges[i].getDirection();
+
+            float cost = (float)(distance + edges[i].getWeight());
+            if (cost >= this->distances[targetId])
+                continue;
+
+            bool open = openList.contains(targetId);
+            this->distances[targetId] = cost;
+            if (open)
+                openList.decrease(targetId, cost, id);
+            else
+                openList.push(targetId, cost, id);
+        }
+    }
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+}
+
+// Caminho de startId até o objetivo seguindo as direções, com o início no topo (vazio se o
+// início não alcança o objetivo). Com o campo velho as direções podem formar um ciclo, então
+// a caminhada para depois de um passo por nó
+template <class Maze>
+stack<int> FlowField::followPath(Maze *maze, int startId)
+{
+    stack<int> pilha;
+    int nodeCount = (int)this->distances.size();
+    if (startId < 0 || startId >= nodeCount || this->distances[startId] == INFINITY)
+        return pilha;
+
+    vector<int> path(1, startId);
+    Edge edges[4];
+    for (int id = startId; id != this->goalId;)
+    {
+        if ((int)path.size() > nodeCount)
+            return pilha;
+
+        int numEdges = maze->getEdges(id, edges);
+        int nextId = -1;
+        for (int i = 0; i < numEdges && nextId < 0; i++)
+            if (edges[i].getDirection() == this->nextHops[id])
+                nextId = edges[i].getTargetId();
+
+        // O labirinto mudou depois do campo ser calculado
+        if (nextId < 0 || nextId >= nodeCount)
+            return pilha;
+
+        path.push_back(nextId);
+        id = nextId;
+    }
+
+    for (int i = (int)path.size() - 1; i >= 0; i--)
+        pilha.push(path[i]);
+    return pilha;
+}
+
+// Getters
+int FlowField::getGoalId()
+{
+    return this->goalId;
+}
+
+unsigned long long FlowField::getVersion()
+{
+    return this->version;
+}
+
+double FlowField::getDistance(int id)
+{
+    return this->distances[id];
+}
+
+int FlowField::getNextHop(int id)
+{
+    return this->nextHops[id] == NO_NEXT_HOP ? -1 : this->nextHops[id];
+}
+
+size_t FlowField::getMemoryUsage()
+{
+    return this->distances.size() * sizeof(float) + this->nextHops.size() * sizeof(uint8_t);
+}
+
+// Tempo do Dijkstra que montou o campo, em segundos
+double FlowField::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+#endif // FLOWFIELD_H
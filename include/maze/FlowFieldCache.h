@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ * Implementation of the TAD FlowFieldCache
+ **************************************************************************************************/
+
+#ifndef FLOWFIELDCACHE_H
+#define FLOWFIELDCACHE_H
+
+#include <list>
+#include <stack>
+
+#include "FlowField.h"
+
+using namespace std;
+
+// Campos de fluxo de um labirinto, um por objetivo, calculados na primeira consulta a cada
+// objetivo. Um campo só é recalculado quando a versão do labirinto muda. Guarda no máximo
+// capacity campos; quando enche, descarta o usado há mais tempo.
+//
+// Os campos ficam em uma lista, então o ponteiro devolvido por getField não muda com as
+// outras consultas; ele só deixa de valer quando o campo é descartado ou no clear.
+template <class Maze>
+class FlowFieldCache
+{
+
+private:
+    Maze *maze;
+    int capacity;
+    list<FlowField> fields; // Do usado mais recentemente para o mais antigo
+    long long hitCount;
+    long long buildCount;
+    long long evictionCount;
+
+public:
+    FlowFieldCache(Maze *maze, int capacity);
+    ~FlowFieldCache();
+
+    // Operations
+    FlowField *getField(int goalId);
+    stack<int> findPath(int startId, int goalId);
+    void clear();
+
+    // Getters
+    int getFieldCount();
+    long long getHitCount();
+    long long getBuildCount();
+    long long getEvictionCount();
+    size_t getMemoryUsage();
+};
+
+// Construtor
+template <class Maze>
+FlowFieldCache<Maze>::FlowFieldCache(Maze *maze, int capacity)
+{
+    this->maze = maze;
+    this->capacity = capacity > 0 ? capacity : 1;
+    this->hitCount = 0;
+    this->buildCount = 0;
+    this->evictionCount = 0;
+}
+
+// Destrutor
+template <class Maze>
+FlowFieldCache<Maze>::~FlowFieldCache()
+{
+    this->maze = nullptr;
+}
+
+// Campo até goalId, recalculado se ainda não existe ou se o labirinto mudou desde o cálculo
+template <class Maze>
+FlowField *FlowFieldCache<Maze>::getField(int goalId)
+{
+    for (auto it = this->fields.begin(); it != this->fields.end(); it++)
+    {
+        if (it->getGoalId() == goalId)
+        {
+            this->fields.splice(this->fields.begin(), this->fields, it);
+            if (it->getVersion() == this->maze->getVersion())
+                this->hitCount++;
+            else
+            {
+                it->build(this->maze, goalId);
+                this->buildCount++;
+            }
+            return &*it;
+        }
+    }
+
+    if ((int)this->fields.size() >= this->capacity)
+    {
+        this->fields.pop_back();
+        this->evictionCount++;
+    }
+
+    this->fields.emplace_front();
+    this->fields.front().build(this->maze, goalId);
+    this->buildCount++;
+    return &this->fields.front();
+}
+
+// Caminho de startId até goalId pelo campo do objetivo, com o início no topo
+template <class Maze>
+stack<int> FlowFieldCache<Maze>::findPath(int startId, int goalId)
+{
+    return this->getField(goalId)->followPath(this->maze, startId);
+}
+
+template <class Maze>
+void FlowFieldCache<Maze>::clear()
+{
+    this->fields.clear();
+}
+
+// Getters
+template <class Maze>
+int FlowFieldCache<Maze>::getFieldCount()
+{
+    return (int)this->fields.size();
+}
+
+template <class Maze>
+long long FlowFieldCache<Maze>::getHitCount()
+{
+    return this->hitCount;
+}
+
+template <class Maze>
+long long FlowFieldCache<Maze>::getBuildCount()
+{
+    return this->buildCount;
+}
+
+template <class Maze>
+long long FlowFieldCache<Maze>::getEvictionCount()
+{
+    return this->evictionCount;
+}
+
+template <class Maze>
+size_t FlowFieldCache<Maze>::getMemoryUsage()
+{
+    size_t bytes = 0;
+    for (FlowField &field : this->fields)
+        bytes += field.getMemoryUsage();
+    return bytes;
+}
+
+#endif // FLOWFIELDCACHE_H
@@ -7,19 +7,34 @@
 
 using namespace std;
 
+#include <algorithm>
+#include <climits>
 #include <iostream>
-#include <sstream>
 #include <cmath>
+#include <vector>
 
 #include "Node.h"
+#include "GridMaze.h"
+#include "Heuristic.h"
 
+// O grafo é armazenado em formato CSR (compressed sparse row): os nós ficam em um vetor
+// denso indexado pelo id e todas as arestas ficam em um único vetor contíguo, agrupadas
+// pelo nó de origem. As arestas inseridas ficam pendentes até finalize() montar o vetor.
 class Graph
 {
 
 private:
-    Node *firstNode;   // Ponteiro para primeiro nó do grafo
-    Node *lastNode;    // Ponteiro para último nó do grafo
-    int nodeIdCounter; // Contador de nós do grafo
+    vector<Node> nodes;        // Nós do grafo, indexados pelo id
+    vector<Edge> edges;        // Arestas agrupadas por nó de origem
+    vector<int> edgeOffsets;   // Arestas do nó i ficam em [edgeOffsets[i], edgeOffsets[i + 1])
+    vector<Edge> pendingEdges; // Arestas inseridas desde o último finalize()
+    int nodeIdCounter;         // Contador de nós do grafo
+    int startId;               // Id do nó inicial
+    int goalId;                // Id do primeiro nó final
+    int maxIntegerWeight;      // Maior peso se todos forem inteiros não negativos, senão -1
+    bool finalized;            // Indica se o vetor CSR está atualizado
+    bool uniformGrid;          // Montado só por insertGrid: grade de 4 vizinhos com custo 1
+    unsigned long long version; // Incrementado a cada nó ou aresta inserido e a cada mudança de heurística
 
 public:
     Graph();
@@ -27,19 +42,36 @@ public:
 
     // Getters
     int getNodeIdCounter();
+    int getEdgeCount();
     Node *getFirstNode();
     Node *getLastNode();
     Node *getNodeById(int id);
+    int getX(int id);
+    int getY(int id);
+    unsigned long long getVersion();
 
     // Insert methods
-    Node *insertNode(string tag, string position);
-    Node *insertNode(string tag, string position, double heuristic);
-    void insertEdge(Node *sourceNode, Node *targetNode, int direction, double weight);
+    void reserve(int nodeCount, int edgeCount);
+    int insertNode(NodeTag tag, int x, int y);
+    int insertNode(NodeTag tag, int x, int y, double heuristic);
+    void insertEdge(int sourceId, int targetId, int direction, double weight);
+    void finalize();
+    void insertGrid(GridMaze *grid);
+    template <class Heuristic = EuclideanHeuristic>
+    void calculateHeuristics(int goalId);
+    double getDistance(int sourceId, int targetId);
+
+    // Interface usada pelas buscas da árvore (a mesma de GridMaze); somente leitura depois de
+    // finalize(), então o mesmo grafo pode ser compartilhado por buscas simultâneas
+    int getNodeCount();
+    int getStartId();
+    int getGoalId();
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    bool isUniformGrid();
 
-    
-
-    double calculateHeuristic(string position, string finalPosition);
-    void extractNumbers(const std::string &s, int &num1, int &num2);
 
     void generateMaze();
     void generateSmallMaze();
@@ -50,25 +82,19 @@ public:
 // Construtor
 Graph::Graph()
 {
-    this->firstNode = this->lastNode = nullptr;
     this->nodeIdCounter = 0;
+    this->startId = -1;
+    this->goalId = -1;
+    this->maxIntegerWeight = 0;
+    this->finalized = true;
+    this->uniformGrid = false;
+    this->version = 0;
 }
 
 // Destrutor
 Graph::~Graph()
 {
-    Node *nextNode = this->firstNode;
-
-    while (nextNode != nullptr)
-    {
-        Node *auxNode = nextNode->getNextNode();
-        delete nextNode;
-        nextNode = auxNode;
-    }
-
     this->nodeIdCounter = 0;
-    this->firstNode = nullptr;
-    this->lastNode = nullptr;
 }
 
 // Getters
@@ -78,248 +104,462 @@ int Graph::getNodeIdCounter()
     return this->nodeIdCounter;
 }
 
+int Graph::getEdgeCount()
+{
+    if (!this->finalized)
+        this->finalize();
+
+    return (int)this->edges.size();
+}
+
 Node *Graph::getFirstNode()
 {
-    return this->firstNode;
+    if (!this->finalized)
+        this->finalize();
+
+    if (this->nodes.empty())
+        return nullptr;
+
+    return &this->nodes.front();
 }
 
 Node *Graph::getLastNode()
 {
-    return this->lastNode;
+    if (!this->finalized)
+        this->finalize();
+
+    if (this->nodes.empty())
+        return nullptr;
+
+    return &this->nodes.back();
 }
 
-Node *Graph::insertNode(string tag, string position)
+// Acesso direto pelo id, O(1)
+Node *Graph::getNodeById(int id)
 {
-    return this->insertNode(tag, position, 999);
+    if (!this->finalized)
+        this->finalize();
+
+    if (id < 0 || id >= (int)this->nodes.size())
+        return nullptr;
+
+    return &this->nodes[id];
 }
 
-Node *Graph::insertNode(string tag, string position, double heuristic)
+int Graph::getX(int id)
 {
-    Node *newNode = new Node(nodeIdCounter++, tag, position, heuristic);
-    if (lastNode == nullptr)
-    {
-        firstNode = newNode;
-        lastNode = newNode;
-    }
-    else
+    return this->nodes[id].getX();
+}
+
+int Graph::getY(int id)
+{
+    return this->nodes[id].getY();
+}
+
+// Muda sempre que o grafo muda; quem guarda resultados calculados sobre o grafo compara a versão
+unsigned long long Graph::getVersion()
+{
+    return this->version;
+}
+
+// Pré-aloca espaço para evitar realocações ao montar grafos grandes
+void Graph::reserve(int nodeCount, int edgeCount)
+{
+    this->nodes.reserve(nodeCount);
+    this->pendingEdges.reserve(edgeCount);
+}
+
+// Nó sem heurística; calculateHeuristics a preenche depois que o objetivo é conhecido
+int Graph::insertNode(NodeTag tag, int x, int y)
+{
+    return this->insertNode(tag, x, y, 0);
+}
+
+int Graph::insertNode(NodeTag tag, int x, int y, double heuristic)
+{
+    this->nodes.emplace_back(nodeIdCounter, tag, x, y, heuristic);
+    if (tag == INITIAL_NODE && this->startId < 0)
+        this->startId = nodeIdCounter;
+    if (tag == FINAL_NODE && this->goalId < 0)
+        this->goalId = nodeIdCounter;
+    this->finalized = false;
+    this->uniformGrid = false;
+    this->version++;
+    return nodeIdCounter++;
+}
+
+// Insere a aresta nos dois sentidos; a aresta de volta recebe a direção oposta
+void Graph::insertEdge(int sourceId, int targetId, int direction, double weight)
+{
+    if (sourceId < 0 || sourceId >= nodeIdCounter || targetId < 0 || targetId >= nodeIdCounter)
+        return;
+
+    Edge edge(sourceId, targetId, weight);
+    edge.setDirection(direction);
+    this->pendingEdges.push_back(edge);
+
+    switch (direction)
     {
-        lastNode->setNextNode(newNode);
-        lastNode = newNode;
+    case 0:
+        direction = 2;
+        break;
+    case 1:
+        direction = 3;
+        break;
+    case 2:
+        direction = 0;
+        break;
+    case 3:
+        direction = 1;
+        break;
+    default:
+        break;
     }
-    return newNode;
+
+    Edge reverseEdge(targetId, sourceId, weight);
+    reverseEdge.setDirection(direction);
+    this->pendingEdges.push_back(reverseEdge);
+
+    this->finalized = false;
+    this->uniformGrid = false;
+    this->version++;
 }
 
-void Graph::insertEdge(Node *sourceNode, Node *targetNode, int direction, double weight)
+// Monta o vetor CSR com counting sort pela origem (estável, preserva a ordem de inserção)
+void Graph::finalize()
 {
-    if (sourceNode != nullptr && targetNode != nullptr)
+    int nodeCount = (int)this->nodes.size();
+
+    vector<Edge> allEdges;
+    allEdges.reserve(this->edges.size() + this->pendingEdges.size());
+    allEdges.insert(allEdges.end(), this->edges.begin(), this->edges.end());
+    allEdges.insert(allEdges.end(), this->pendingEdges.begin(), this->pendingEdges.end());
+    this->pendingEdges.clear();
+    this->pendingEdges.shrink_to_fit();
+
+    this->edgeOffsets.assign(nodeCount + 1, 0);
+    for (Edge &edge : allEdges)
+        this->edgeOffsets[edge.getSourceId() + 1]++;
+
+    for (int i = 0; i < nodeCount; i++)
+        this->edgeOffsets[i + 1] += this->edgeOffsets[i];
+
+    vector<int> order(allEdges.size());
+    vector<int> cursor(this->edgeOffsets.begin(), this->edgeOffsets.end() - 1);
+    for (int i = 0; i < (int)allEdges.size(); i++)
+        order[cursor[allEdges[i].getSourceId()]++] = i;
+
+    this->edges.clear();
+    this->edges.reserve(allEdges.size());
+    for (int index : order)
+        this->edges.push_back(allEdges[index]);
+
+    // Encadeia nós e arestas dentro do vetor para manter a navegação por ponteiros
+    for (int i = 0; i < nodeCount; i++)
     {
-        int sourceNodeId = sourceNode->getId();
-        int targetNodeId = targetNode->getId();
-        sourceNode->insertEdge(sourceNodeId, targetNodeId, direction, weight);
-        switch (direction)
+        int begin = this->edgeOffsets[i];
+        int end = this->edgeOffsets[i + 1];
+
+        for (int e = begin; e < end; e++)
+            this->edges[e].setNextEdge(e + 1 < end ? &this->edges[e + 1] : nullptr);
+
+        if (begin < end)
+            this->nodes[i].setEdges(&this->edges[begin], &this->edges[end - 1]);
+        else
+            this->nodes[i].setEdges(nullptr, nullptr);
+
+        this->nodes[i].setNextNode(i + 1 < nodeCount ? &this->nodes[i + 1] : nullptr);
+    }
+
+    // Pesos inteiros permitem às buscas usar a fila de baldes no lugar do heap
+    this->maxIntegerWeight = 0;
+    for (Edge &edge : this->edges)
+    {
+        double weight = edge.getWeight();
+        if (weight < 0 || weight != floor(weight) || weight > INT_MAX)
         {
-        case 0:
-            direction = 2;
-            break;
-        case 1:
-            direction = 3;
-            break;
-        case 2:
-            direction = 0;
-            break;
-        case 3:
-            direction = 1;
-            break;
-        default:
+            this->maxIntegerWeight = -1;
             break;
         }
-        targetNode->insertEdge(sourceNodeId, targetNodeId, direction, weight);
+        this->maxIntegerWeight = max(this->maxIntegerWeight, (int)weight);
     }
+
+    this->finalized = true;
 }
 
-Node *Graph::getNodeById(int id)
+// Recalcula a heurística de todos os nós até o nó goalId com a política Heuristic (ver
+// Heuristic.h)
+template <class Heuristic>
+void Graph::calculateHeuristics(int goalId)
 {
-    Node *nextNode = this->firstNode;
-    while (nextNode != nullptr)
-    {
-        if (nextNode->getId() == id)
-            return nextNode;
+    int goalX = this->nodes[goalId].getX();
+    int goalY = this->nodes[goalId].getY();
 
-        nextNode = nextNode->getNextNode();
-    }
-    return nullptr;
+    for (Node &node : this->nodes)
+        node.setHeuristic(Heuristic::estimate(goalX - node.getX(), goalY - node.getY()));
+    this->version++;
 }
 
-void Graph::extractNumbers(const std::string &s, int &num1, int &num2)
+// Distância euclidiana entre as posições de dois nós
+double Graph::getDistance(int sourceId, int targetId)
 {
-    std::stringstream ss(s);
-    char comma; // para armazenar a vírgula
+    return EuclideanHeuristic::estimate(this->nodes[targetId].getX() - this->nodes[sourceId].getX(),
+                                        this->nodes[targetId].getY() - this->nodes[sourceId].getY());
+}
 
-    ss >> num1 >> comma >> num2;
+int Graph::getNodeCount()
+{
+    return this->nodeIdCounter;
 }
 
-double Graph::calculateHeuristic(string position, string finalPosition)
+// Nó inicial: o primeiro marcado como inicial, ou o primeiro nó inserido
+int Graph::getStartId()
 {
-    int positionX, positionY, finalPositionX, finalPositionY;
+    if (this->nodeIdCounter == 0)
+        return -1;
 
-    this->extractNumbers(position, positionX, positionY);
-    this->extractNumbers(finalPosition, finalPositionX, finalPositionY);
+    return this->startId >= 0 ? this->startId : 0;
+}
 
-    double heuristic = sqrt(pow(finalPositionX - positionX, 2) + pow(finalPositionY - positionY, 2));
+// Nó final: o primeiro marcado como final, ou -1 se não há nenhum
+int Graph::getGoalId()
+{
+    return this->goalId;
+}
 
-    return heuristic;
+bool Graph::isFinal(int id)
+{
+    return this->nodes[id].isFinal();
 }
 
-void Graph::generateSmallMaze()
+double Graph::getHeuristic(int id)
+{
+    return this->nodes[id].getHeuristic();
+}
+
+// Copia até 4 arestas que saem do nó, na ordem em que foram inseridas
+int Graph::getEdges(int id, Edge edges[4])
+{
+    if (!this->finalized)
+        this->finalize();
+
+    int begin = this->edgeOffsets[id];
+    int end = this->edgeOffsets[id + 1];
+
+    int count = 0;
+    for (int e = begin; e < end && count < 4; e++)
+        edges[count++] = this->edges[e];
+
+    return count;
+}
+
+// Maior peso das arestas se todos forem inteiros não negativos; -1 caso contrário
+int Graph::getMaxIntegerWeight()
+{
+    if (!this->finalized)
+        this->finalize();
+
+    return this->maxIntegerWeight;
+}
+
+// Verdadeiro só se o grafo inteiro veio de uma grade (insertGrid em um grafo vazio, sem nós ou
+// arestas inseridos depois): as direções formam a grade e todo passo custa 1
+bool Graph::isUniformGrid()
+{
+    return this->uniformGrid;
+}
+
+// Monta o grafo em bloco a partir de um labirinto em grade: o id de cada nó é o id da célula
+// e cada passagem vira uma aresta de peso 1 nos dois sentidos
+void Graph::insertGrid(GridMaze *grid)
 {
+    int cellCount = grid->getNodeCount();
+    int goalX = grid->getX(grid->getGoalId());
+    int goalY = grid->getY(grid->getGoalId());
+    int firstId = this->nodeIdCounter;
+    bool empty = firstId == 0;
 
-    string finalNodePosition = "3,1";
+    this->reserve(this->nodeIdCounter + cellCount, (int)this->edges.size() + 4 * cellCount);
+
+    for (int id = 0; id < cellCount; id++)
+    {
+        NodeTag tag = INTERMEDIATE_NODE;
+        if (id == grid->getStartId())
+            tag = INITIAL_NODE;
+        else if (grid->isFinal(id))
+            tag = FINAL_NODE;
+
+        int x = grid->getX(id);
+        int y = grid->getY(id);
+        this->insertNode(tag, x, y, EuclideanHeuristic::estimate(goalX - x, goalY - y));
+    }
+
+    for (int id = 0; id < cellCount; id++)
+    {
+        // Cima e direita bastam: insertEdge já cria a aresta de volta
+        if (grid->hasPassage(id, 0))
+            this->insertEdge(firstId + id, firstId + grid->getNeighbourId(id, 0), 0, 1);
+        if (grid->hasPassage(id, 3))
+            this->insertEdge(firstId + id, firstId + grid->getNeighbourId(id, 3), 3, 1);
+    }
+
+    this->finalize();
+    this->uniformGrid = empty;
+}
+
+void Graph::generateSmallMaze()
+{
 
-    Node *node0 = this->insertNode("inicial", "2,2", this->calculateHeuristic("2,2", finalNodePosition));
-    Node *node1 = this->insertNode("intermediario", "1,2", this->calculateHeuristic("1,2", finalNodePosition));
-    Node *node2 = this->insertNode("intermediario", "1,1", this->calculateHeuristic("1,1", finalNodePosition));
-    Node *node3 = this->insertNode("intermediario", "0,1", this->calculateHeuristic("0,1", finalNodePosition));
-    Node *node4 = this->insertNode("intermediario", "2,1", this->calculateHeuristic("2,1", finalNodePosition));
-    Node *node5 = this->insertNode("intermediario", "2,0", this->calculateHeuristic("2,0", finalNodePosition));
-    Node *node6 = this->insertNode("final", finalNodePosition, this->calculateHeuristic(finalNodePosition, finalNodePosition));
-    Node *node7 = this->insertNode("intermediario", "0,2", this->calculateHeuristic("0,2", finalNodePosition));
+    int node0 = this->insertNode(INITIAL_NODE, 2, 2);
+    int node1 = this->insertNode(INTERMEDIATE_NODE, 1, 2);
+    int node2 = this->insertNode(INTERMEDIATE_NODE, 1, 1);
+    int node3 = this->insertNode(INTERMEDIATE_NODE, 0, 1);
+    int node4 = this->insertNode(INTERMEDIATE_NODE, 2, 1);
+    int node5 = this->insertNode(INTERMEDIATE_NODE, 2, 0);
+    int node6 = this->insertNode(FINAL_NODE, 3, 1);
+    int node7 = this->insertNode(INTERMEDIATE_NODE, 0, 2);
 
     //NOVAS ADIÇÕES
-    Node *node8 = this->insertNode("intermediario", "0,0", this->calculateHeuristic("0,0", finalNodePosition));
-    Node *node9 = this->insertNode("intermediario", "-1,0", this->calculateHeuristic("-1,0", finalNodePosition));
-    Node *node10 = this->insertNode("intermediario", "1,0", this->calculateHeuristic("1,0", finalNodePosition));
-    Node *node11 = this->insertNode("intermediario", "2,3", this->calculateHeuristic("2,3", finalNodePosition));
-    Node *node12 = this->insertNode("intermediario", "1,3", this->calculateHeuristic("1,3", finalNodePosition));
+    int node8 = this->insertNode(INTERMEDIATE_NODE, 0, 0);
+    int node9 = this->insertNode(INTERMEDIATE_NODE, -1, 0);
+    int node10 = this->insertNode(INTERMEDIATE_NODE, 1, 0);
+    int node11 = this->insertNode(INTERMEDIATE_NODE, 2, 3);
+    int node12 = this->insertNode(INTERMEDIATE_NODE, 1, 3);
 
-    this->insertEdge(node3, node8, 2, this->calculateHeuristic("0,1", "0,0"));
-    this->insertEdge(node8, node9, 1, this->calculateHeuristic("0,0", "-1,0"));
-    this->insertEdge(node8, node10, 3, this->calculateHeuristic("0,0", "1,0"));
-    this->insertEdge(node1, node12, 0, this->calculateHeuristic("1,2",  "1,3"));
-    this->insertEdge(node12, node11, 0, this->calculateHeuristic("1,3",  "2,3"));
+    this->insertEdge(node3, node8, 2, this->getDistance(node3, node8));
+    this->insertEdge(node8, node9, 1, this->getDistance(node8, node9));
+    this->insertEdge(node8, node10, 3, this->getDistance(node8, node10));
+    this->insertEdge(node1, node12, 0, this->getDistance(node1, node12));
+    this->insertEdge(node12, node11, 0, this->getDistance(node12, node11));
 
 
     //ANTIGAS
-    this->insertEdge(node0, node1, 1, this->calculateHeuristic("2,2", "1,2"));
-    this->insertEdge(node1, node2, 2, this->calculateHeuristic("1,2", "1,1"));
-    this->insertEdge(node2, node3, 1, this->calculateHeuristic("1,1", "0,1"));
-    this->insertEdge(node2, node4, 3, this->calculateHeuristic("1,1", "2,1") );
-    this->insertEdge(node4, node5, 2, this->calculateHeuristic("2,1", "2,0"));
-    this->insertEdge(node3, node7, 0, this->calculateHeuristic("0,1", "0,2"));
-    this->insertEdge(node4, node6, 3, this->calculateHeuristic("2,1", finalNodePosition));
- 
+    this->insertEdge(node0, node1, 1, this->getDistance(node0, node1));
+    this->insertEdge(node1, node2, 2, this->getDistance(node1, node2));
+    this->insertEdge(node2, node3, 1, this->getDistance(node2, node3));
+    this->insertEdge(node2, node4, 3, this->getDistance(node2, node4));
+    this->insertEdge(node4, node5, 2, this->getDistance(node4, node5));
+    this->insertEdge(node3, node7, 0, this->getDistance(node3, node7));
+    this->insertEdge(node4, node6, 3, this->getDistance(node4, node6));
+
+    // Heurística até o nó marcado como final
+    this->calculateHeuristics(this->goalId);
+    this->finalize();
 }
 
 void Graph::generateMaze()
 {
-    string finalPosition = "9,0";
-
-    Node *node0 = this->insertNode("inicial", "0,4", this->calculateHeuristic("0,4", finalPosition));
-    Node *node1 = this->insertNode("intermediario", "2,4", this->calculateHeuristic("2,4", finalPosition));
-    Node *node2 = this->insertNode("intermediario", "2,3", this->calculateHeuristic("2,3", finalPosition));
-    Node *node3 = this->insertNode("intermediario", "1,3", this->calculateHeuristic("1,3", finalPosition));
-    Node *node4 = this->insertNode("intermediario", "0,2", this->calculateHeuristic("0,2", finalPosition));
-    Node *node5 = this->insertNode("intermediario", "1,2", this->calculateHeuristic("1,2", finalPosition));
-    Node *node6 = this->insertNode("intermediario", "1,1", this->calculateHeuristic("1,1", finalPosition));
-    Node *node7 = this->insertNode("intermediario", "2,1", this->calculateHeuristic("2,1", finalPosition));
-    Node *node8 = this->insertNode("intermediario", "2,2", this->calculateHeuristic("2,2", finalPosition));
-    Node *node9 = this->insertNode("intermediario", "3,2", this->calculateHeuristic("3,2", finalPosition));
-    Node *node10 = this->insertNode("intermediario", "0,1", this->calculateHeuristic("0,1", finalPosition));
-    Node *node11 = this->insertNode("intermediario", "0,0", this->calculateHeuristic("0,0", finalPosition));
-    Node *node12 = this->insertNode("intermediario", "3,0", this->calculateHeuristic("3,0", finalPosition));
-    Node *node13 = this->insertNode("intermediario", "3,1", this->calculateHeuristic("3,1", finalPosition));
-    Node *node14 = this->insertNode("intermediario", "4,1", this->calculateHeuristic("4,1", finalPosition));
-    Node *node15 = this->insertNode("intermediario", "4,0", this->calculateHeuristic("4,0", finalPosition));
-    Node *node16 = this->insertNode("intermediario", "5,0", this->calculateHeuristic("5,0", finalPosition));
-    Node *node17 = this->insertNode("intermediario", "4,2", this->calculateHeuristic("4,2", finalPosition));
-    Node *node18 = this->insertNode("intermediario", "5,2", this->calculateHeuristic("5,2", finalPosition));
-    Node *node19 = this->insertNode("intermediario", "5,1", this->calculateHeuristic("5,1", finalPosition));
-    Node *node20 = this->insertNode("intermediario", "6,1", this->calculateHeuristic("6,1", finalPosition));
-    Node *node21 = this->insertNode("intermediario", "4,3", this->calculateHeuristic("4,3", finalPosition));
-    Node *node22 = this->insertNode("intermediario", "3,3", this->calculateHeuristic("3,3", finalPosition));
-    Node *node23 = this->insertNode("intermediario", "3,4", this->calculateHeuristic("3,4", finalPosition));
-    Node *node24 = this->insertNode("intermediario", "5,4", this->calculateHeuristic("5,4", finalPosition));
-    Node *node25 = this->insertNode("intermediario", "5,3", this->calculateHeuristic("5,3", finalPosition));
-    Node *node26 = this->insertNode("intermediario", "6,3", this->calculateHeuristic("6,3", finalPosition));
-    Node *node27 = this->insertNode("intermediario", "6,2", this->calculateHeuristic("6,2", finalPosition));
-    Node *node28 = this->insertNode("intermediario", "7,2", this->calculateHeuristic("7,2", finalPosition));
-    Node *node29 = this->insertNode("intermediario", "7,3", this->calculateHeuristic("7,3", finalPosition));
-    Node *node30 = this->insertNode("intermediario", "6,4", this->calculateHeuristic("6,4", finalPosition));
-    Node *node31 = this->insertNode("intermediario", "9,4", this->calculateHeuristic("9,4", finalPosition));
-    Node *node32 = this->insertNode("intermediario", "9,3", this->calculateHeuristic("9,3", finalPosition));
-    Node *node33 = this->insertNode("intermediario", "8,3", this->calculateHeuristic("8,3", finalPosition));
-    Node *node34 = this->insertNode("intermediario", "8,1", this->calculateHeuristic("8,1", finalPosition));
-    Node *node35 = this->insertNode("intermediario", "9,1", this->calculateHeuristic("9,1", finalPosition));
-    Node *node36 = this->insertNode("intermediario", "9,2", this->calculateHeuristic("9,2", finalPosition));
-    Node *node37 = this->insertNode("intermediario", "7,1", this->calculateHeuristic("7,1", finalPosition));
-    Node *node38 = this->insertNode("intermediario", "7,0", this->calculateHeuristic("7,0", finalPosition));
-    Node *node39 = this->insertNode("intermediario", "6,0", this->calculateHeuristic("6,0", finalPosition));
+    int node0 = this->insertNode(INITIAL_NODE, 0, 4);
+    int node1 = this->insertNode(INTERMEDIATE_NODE, 2, 4);
+    int node2 = this->insertNode(INTERMEDIATE_NODE, 2, 3);
+    int node3 = this->insertNode(INTERMEDIATE_NODE, 1, 3);
+    int node4 = this->insertNode(INTERMEDIATE_NODE, 0, 2);
+    int node5 = this->insertNode(INTERMEDIATE_NODE, 1, 2);
+    int node6 = this->insertNode(INTERMEDIATE_NODE, 1, 1);
+    int node7 = this->insertNode(INTERMEDIATE_NODE, 2, 1);
+    int node8 = this->insertNode(INTERMEDIATE_NODE, 2, 2);
+    int node9 = this->insertNode(INTERMEDIATE_NODE, 3, 2);
+    int node10 = this->insertNode(INTERMEDIATE_NODE, 0, 1);
+    int node11 = this->insertNode(INTERMEDIATE_NODE, 0, 0);
+    int node12 = this->insertNode(INTERMEDIATE_NODE, 3, 0);
+    int node13 = this->insertNode(INTERMEDIATE_NODE, 3, 1);
+    int node14 = this->insertNode(INTERMEDIATE_NODE, 4, 1);
+    int node15 = this->insertNode(INTERMEDIATE_NODE, 4, 0);
+    int node16 = this->insertNode(INTERMEDIATE_NODE, 5, 0);
+    int node17 = this->insertNode(INTERMEDIATE_NODE, 4, 2);
+    int node18 = this->insertNode(INTERMEDIATE_NODE, 5, 2);
+    int node19 = this->insertNode(INTERMEDIATE_NODE, 5, 1);
+    int node20 = this->insertNode(INTERMEDIATE_NODE, 6, 1);
+    int node21 = this->insertNode(INTERMEDIATE_NODE, 4, 3);
+    int node22 = this->insertNode(INTERMEDIATE_NODE, 3, 3);
+    int node23 = this->insertNode(INTERMEDIATE_NODE, 3, 4);
+    int node24 = this->insertNode(INTERMEDIATE_NODE, 5, 4);
+    int node25 = this->insertNode(INTERMEDIATE_NODE, 5, 3);
+    int node26 = this->insertNode(INTERMEDIATE_NODE, 6, 3);
+    int node27 = this->insertNode(INTERMEDIATE_NODE, 6, 2);
+    int node28 = this->insertNode(INTERMEDIATE_NODE, 7, 2);
+    int node29 = this->insertNode(INTERMEDIATE_NODE, 7, 3);
+    int node30 = this->insertNode(INTERMEDIATE_NODE, 6, 4);
+    int node31 = this->insertNode(INTERMEDIATE_NODE, 9, 4);
+    int node32 = this->insertNode(INTERMEDIATE_NODE, 9, 3);
+    int node33 = this->insertNode(INTERMEDIATE_NODE, 8, 3);
+    int node34 = this->insertNode(INTERMEDIATE_NODE, 8, 1);
+    int node35 = this->insertNode(INTERMEDIATE_NODE, 9, 1);
+    int node36 = this->insertNode(INTERMEDIATE_NODE, 9, 2);
+    int node37 = this->insertNode(INTERMEDIATE_NODE, 7, 1);
+    int node38 = this->insertNode(INTERMEDIATE_NODE, 7, 0);
+    int node39 = this->insertNode(INTERMEDIATE_NODE, 6, 0);
 
     // NOVAS ADIÇÕES
-    Node *node40 = this->insertNode("intermediario", "0,-1", this->calculateHeuristic("0,-1", finalPosition));
-    Node *node41 = this->insertNode("intermediario", "0,-2", this->calculateHeuristic("0,-2", finalPosition));
-    Node *node42 = this->insertNode("intermediario", "3,-2", this->calculateHeuristic("3,-2", finalPosition));
-    Node *node43 = this->insertNode("intermediario", "1,-1", this->calculateHeuristic("1,-1", finalPosition));
-    Node *node44 = this->insertNode("intermediario", "4,-1", this->calculateHeuristic("4,-1", finalPosition));
-    Node *node45 = this->insertNode("intermediario", "3,-1", this->calculateHeuristic("3,-1", finalPosition));
-    Node *node46 = this->insertNode("intermediario", "6,-1", this->calculateHeuristic("6,-1", finalPosition));
-    Node *node47 = this->insertNode("final", "7,-2", this->calculateHeuristic("7,-2", finalPosition));
-
-    Node *node48 = this->insertNode("intermediario", "9,0", this->calculateHeuristic("9,0", finalPosition));
-
-    this->insertEdge(node11, node40, 2, this->calculateHeuristic("0,0", "0,-1"));
-    this->insertEdge(node40, node41, 2, this->calculateHeuristic("0,-1", "0,-2"));
-    this->insertEdge(node40, node43, 3, this->calculateHeuristic("0,-1", "1,-1"));
-    this->insertEdge(node41, node42, 3, this->calculateHeuristic("0,-2", "3,-2"));
-    this->insertEdge(node15, node44, 2, this->calculateHeuristic("4,0", "4,-1"));
-    this->insertEdge(node37, node28, 0, this->calculateHeuristic("7,1", "7,2"));
-    this->insertEdge(node25, node18, 2, this->calculateHeuristic("5,3", "5,2"));
-    this->insertEdge(node43, node45, 3, this->calculateHeuristic("1,-1", "3,-1"));
-    this->insertEdge(node44, node46, 3, this->calculateHeuristic("4,-1", "6,-1"));
-    this->insertEdge(node38, node47, 2, this->calculateHeuristic("7,0", "7,-2"));
+    int node40 = this->insertNode(INTERMEDIATE_NODE, 0, -1);
+    int node41 = this->insertNode(INTERMEDIATE_NODE, 0, -2);
+    int node42 = this->insertNode(INTERMEDIATE_NODE, 3, -2);
+    int node43 = this->insertNode(INTERMEDIATE_NODE, 1, -1);
+    int node44 = this->insertNode(INTERMEDIATE_NODE, 4, -1);
+    int node45 = this->insertNode(INTERMEDIATE_NODE, 3, -1);
+    int node46 = this->insertNode(INTERMEDIATE_NODE, 6, -1);
+    int node47 = this->insertNode(FINAL_NODE, 7, -2);
+
+    int node48 = this->insertNode(INTERMEDIATE_NODE, 9, 0);
+
+    this->insertEdge(node11, node40, 2, this->getDistance(node11, node40));
+    this->insertEdge(node40, node41, 2, this->getDistance(node40, node41));
+    this->insertEdge(node40, node43, 3, this->getDistance(node40, node43));
+    this->insertEdge(node41, node42, 3, this->getDistance(node41, node42));
+    this->insertEdge(node15, node44, 2, this->getDistance(node15, node44));
+    this->insertEdge(node37, node28, 0, this->getDistance(node37, node28));
+    this->insertEdge(node25, node18, 2, this->getDistance(node25, node18));
+    this->insertEdge(node43, node45, 3, this->getDistance(node43, node45));
+    this->insertEdge(node44, node46, 3, this->getDistance(node44, node46));
+    this->insertEdge(node38, node47, 2, this->getDistance(node38, node47));
 
     // 0 -- cima
     // 1 -- esquerda
     // 2 -- baixo
     // 3 -- direita
 
-    this->insertEdge(node0, node1, 3, this->calculateHeuristic("0,4", "2,4"));
-    this->insertEdge(node1, node2, 2, this->calculateHeuristic("2,4", "2,3"));
-    this->insertEdge(node2, node3, 1, this->calculateHeuristic("2,3", "1,3"));
-    this->insertEdge(node0, node4, 2, this->calculateHeuristic("0,4", "0,2"));
-    this->insertEdge(node4, node5, 3, this->calculateHeuristic("0,2", "1,2"));
-    this->insertEdge(node5, node6, 2, this->calculateHeuristic("1,2", "1,1"));
-    this->insertEdge(node6, node7, 3, this->calculateHeuristic("1,1", "2,1"));
-    this->insertEdge(node7, node8, 0, this->calculateHeuristic("2,1", "2,2"));
-    this->insertEdge(node8, node9, 3, this->calculateHeuristic("2,2", "3,2"));
-    this->insertEdge(node6, node10, 1, this->calculateHeuristic("1,1", "0,1"));
-    this->insertEdge(node10, node11, 2, this->calculateHeuristic("0,1", "0,0"));
-    this->insertEdge(node11, node12, 3, this->calculateHeuristic("0,0", "3,0"));
-    this->insertEdge(node12, node13, 0, this->calculateHeuristic("3,0", "3,1"));
-    this->insertEdge(node13, node14, 3, this->calculateHeuristic("3,1", "4,1"));
-    this->insertEdge(node14, node15, 2, this->calculateHeuristic("4,1", "4,0"));
-    this->insertEdge(node15, node16, 3, this->calculateHeuristic("4,0", "5,0"));
-    this->insertEdge(node14, node17, 0, this->calculateHeuristic("4,1", "4,2"));
-    this->insertEdge(node18, node19, 2, this->calculateHeuristic("5,2", "5,1"));
-    this->insertEdge(node19, node20, 3, this->calculateHeuristic("5,1", "6,1"));
-    this->insertEdge(node17, node21, 0, this->calculateHeuristic("4,2", "4,3"));
-    this->insertEdge(node21, node22, 1, this->calculateHeuristic("4,3", "3,3"));
-    this->insertEdge(node22, node23, 0, this->calculateHeuristic("3,3", "3,4"));
-    this->insertEdge(node23, node24, 3, this->calculateHeuristic("3,4", "5,4"));
-    this->insertEdge(node24, node25, 2, this->calculateHeuristic("5,4", "5,3"));
-    this->insertEdge(node25, node26, 3, this->calculateHeuristic("5,3", "6,3"));
-    this->insertEdge(node26, node27, 2, this->calculateHeuristic("6,3", "6,2"));
-    this->insertEdge(node28, node29, 0, this->calculateHeuristic("7,2", "7,3"));
-    this->insertEdge(node26, node30, 0, this->calculateHeuristic("6,3", "6,4"));
-    this->insertEdge(node30, node31, 3, this->calculateHeuristic("6,4", "9,4"));
-    this->insertEdge(node31, node32, 2, this->calculateHeuristic("9,4", "9,3"));
-    this->insertEdge(node32, node33, 1, this->calculateHeuristic("9,3", "8,3"));
-    this->insertEdge(node33, node34, 2, this->calculateHeuristic("8,3", "8,1"));
-    this->insertEdge(node34, node35, 3, this->calculateHeuristic("8,1", "9,1"));
-    this->insertEdge(node35, node36, 0, this->calculateHeuristic("9,1", "9,2"));
-    this->insertEdge(node34, node37, 1, this->calculateHeuristic("8,1", "7,1"));
-    this->insertEdge(node37, node38, 2, this->calculateHeuristic("7,1", "7,0"));
-    this->insertEdge(node38, node39, 1, this->calculateHeuristic("7,0", "6,0"));
-    this->insertEdge(node38, node48, 3, this->calculateHeuristic("7,0", "9,0"));
+    this->insertEdge(node0, node1, 3, this->getDistance(node0, node1));
+    this->insertEdge(node1, node2, 2, this->getDistance(node1, node2));
+    this->insertEdge(node2, node3, 1, this->getDistance(node2, node3));
+    this->insertEdge(node0, node4, 2, this->getDistance(node0, node4));
+    this->insertEdge(node4, node5, 3, this->getDistance(node4, node5));
+    this->insertEdge(node5, node6, 2, this->getDistance(node5, node6));
+    this->insertEdge(node6, node7, 3, this->getDistance(node6, node7));
+    this->insertEdge(node7, node8, 0, this->getDistance(node7, node8));
+    this->insertEdge(node8, node9, 3, this->getDistance(node8, node9));
+    this->insertEdge(node6, node10, 1, this->getDistance(node6, node10));
+    this->insertEdge(node10, node11, 2, this->getDistance(node10, node11));
+    this->insertEdge(node11, node12, 3, this->getDistance(node11, node12));
+    this->insertEdge(node12, node13, 0, this->getDistance(node12, node13));
+    this->insertEdge(node13, node14, 3, this->getDistance(node13, node14));
+    this->insertEdge(node14, node15, 2, this->getDistance(node14, node15));
+    this->insertEdge(node15, node16, 3, this->getDistance(node15, node16));
+    this->insertEdge(node14, node17, 0, this->getDistance(node14, node17));
+    this->insertEdge(node18, node19, 2, this->getDistance(node18, node19));
+    this->insertEdge(node19, node20, 3, this->getDistance(node19, node20));
+    this->insertEdge(node17, node21, 0, this->getDistance(node17, node21));
+    this->insertEdge(node21, node22, 1, this->getDistance(node21, node22));
+    this->insertEdge(node22, node23, 0, this->getDistance(node22, node23));
+    this->insertEdge(node23, node24, 3, this->getDistance(node23, node24));
+    this->insertEdge(node24, node25, 2, this->getDistance(node24, node25));
+    this->insertEdge(node25, node26, 3, this->getDistance(node25, node26));
+    this->insertEdge(node26, node27, 2, this->getDistance(node26, node27));
+    this->insertEdge(node28, node29, 0, this->getDistance(node28, node29));
+    this->insertEdge(node26, node30, 0, this->getDistance(node26, node30));
+    this->insertEdge(node30, node31, 3, this->getDistance(node30, node31));
+    this->insertEdge(node31, node32, 2, this->getDistance(node31, node32));
+    this->insertEdge(node32, node33, 1, this->getDistance(node32, node33));
+    this->insertEdge(node33, node34, 2, this->getDistance(node33, node34));
+    this->insertEdge(node34, node35, 3, this->getDistance(node34, node35));
+    this->insertEdge(node35, node36, 0, this->getDistance(node35, node36));
+    this->insertEdge(node34, node37, 1, this->getDistance(node34, node37));
+    this->insertEdge(node37, node38, 2, this->getDistance(node37, node38));
+    this->insertEdge(node38, node39, 1, this->getDistance(node38, node39));
+    this->insertEdge(node38, node48, 3, this->getDistance(node38, node48));
+
+    // Heurística até o nó marcado como final
+    this->calculateHeuristics(this->goalId);
+    this->finalize();
 }
 
 #endif // GRAPH_H
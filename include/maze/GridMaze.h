@@ -0,0 +1,281 @@
+/**************************************************************************************************
+ * Implementation of the TAD GridMaze
+ **************************************************************************************************/
+
+#ifndef GRIDMAZE_H
+#define GRIDMAZE_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Edge.h"
+#include "Heuristic.h"
+
+using namespace std;
+
+// Labirinto em grade guardado apenas como bits de parede: cada célula usa 2 bits
+// (passagem para cima e passagem para a direita); as passagens para baixo e para a
+// esquerda são lidas da célula vizinha. As arestas são geradas sob demanda em getEdges,
+// então não existe nenhum Node ou Edge alocado por célula.
+//
+// Células são identificadas por id = y * width + x, com y crescendo para cima, assim
+// como as posições "x,y" do Graph. Direções: 0 -- cima, 1 -- esquerda, 2 -- baixo, 3 -- direita.
+class GridMaze
+{
+
+private:
+    int width;
+    int height;
+    int startId;
+    int goalId;
+    vector<uint8_t> passages; // 2 bits por célula: bit 0 -> cima, bit 1 -> direita
+    unsigned long long version; // Incrementado a cada mudança nas passagens
+
+    bool getPassageBit(int id, int bit);
+    void setPassageBit(int id, int bit, bool open);
+
+public:
+    GridMaze(int width, int height);
+    ~GridMaze();
+
+    // Getters
+    int getWidth();
+    int getHeight();
+    int getX(int id);
+    int getY(int id);
+    int getCellId(int x, int y);
+    int getGoalId();
+    bool hasPassage(int id, int direction);
+    int getNeighbourId(int id, int direction);
+    unsigned long long getVersion();
+
+    // Setters
+    void setStart(int id);
+    void setGoal(int id);
+    void setPassage(int id, int direction, bool open);
+    void setCellPassages(int id, bool up, bool right);
+
+    // Interface usada pelas buscas da árvore (a mesma do Graph)
+    int getNodeCount();
+    int getStartId();
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    bool isUniformGrid();
+};
+
+// Construtor: labirinto com todas as paredes fechadas
+GridMaze::GridMaze(int width, int height)
+{
+    this->width = width;
+    this->height = height;
+    this->startId = 0;
+    this->goalId = width * height - 1;
+    this->version = 0;
+
+    long long cells = (long long)width * height;
+    this->passages.assign((cells + 3) / 4, 0);
+}
+
+// Destrutor
+GridMaze::~GridMaze()
+{
+    this->width = 0;
+    this->height = 0;
+}
+
+bool GridMaze::getPassageBit(int id, int bit)
+{
+    int shift = (id & 3) * 2 + bit;
+    return (this->passages[id >> 2] >> shift) & 1;
+}
+
+void GridMaze::setPassageBit(int id, int bit, bool open)
+{
+    int shift = (id & 3) * 2 + bit;
+    if (open)
+        this->passages[id >> 2] |= (uint8_t)(1 << shift);
+    else
+        this->passages[id >> 2] &= (uint8_t)~(1 << shift);
+}
+
+// Getters
+int GridMaze::getWidth()
+{
+    return this->width;
+}
+
+int GridMaze::getHeight()
+{
+    return this->height;
+}
+
+int GridMaze::getX(int id)
+{
+    return id % this->width;
+}
+
+int GridMaze::getY(int id)
+{
+    return id / this->width;
+}
+
+int GridMaze::getCellId(int x, int y)
+{
+    return y * this->width + x;
+}
+
+int GridMaze::getGoalId()
+{
+    return this->goalId;
+}
+
+// Id da célula vizinha na direção dada, ou -1 se estiver fora da grade
+int GridMaze::getNeighbourId(int id, int direction)
+{
+    int x = this->getX(id);
+    int y = this->getY(id);
+
+    switch (direction)
+    {
+    case 0:
+        return y + 1 < this->height ? id + this->width : -1;
+    case 1:
+        return x > 0 ? id - 1 : -1;
+    case 2:
+        return y > 0 ? id - this->width : -1;
+    case 3:
+        return x + 1 < this->width ? id + 1 : -1;
+    default:
+        return -1;
+    }
+}
+
+bool GridMaze::hasPassage(int id, int direction)
+{
+    int neighbourId = this->getNeighbourId(id, direction);
+    if (neighbourId < 0)
+        return false;
+
+    switch (direction)
+    {
+    case 0:
+        return this->getPassageBit(id, 0);
+    case 1:
+        return this->getPassageBit(neighbourId, 1);
+    case 2:
+        return this->getPassageBit(neighbourId, 0);
+    case 3:
+        return this->getPassageBit(id, 1);
+    default:
+        return false;
+    }
+}
+
+// Muda a cada passagem aberta ou fechada
+unsigned long long GridMaze::getVersion()
+{
+    return this->version;
+}
+
+// Setters
+void GridMaze::setStart(int id)
+{
+    this->startId = id;
+}
+
+void GridMaze::setGoal(int id)
+{
+    this->goalId = id;
+}
+
+// Abre ou fecha a parede entre a célula e sua vizinha na direção dada
+void GridMaze::setPassage(int id, int direction, bool open)
+{
+    int neighbourId = this->getNeighbourId(id, direction);
+    if (neighbourId < 0)
+        return;
+
+    this->version++;
+
+    switch (direction)
+    {
+    case 0:
+        this->setPassageBit(id, 0, open);
+        break;
+    case 1:
+        this->setPassageBit(neighbourId, 1, open);
+        break;
+    case 2:
+        this->setPassageBit(neighbourId, 0, open);
+        break;
+    case 3:
+        this->setPassageBit(id, 1, open);
+        break;
+    }
+}
+
+// Abre as passagens da célula (cima e direita) direto nos bits, sem checar os limites da
+// grade e sem fechar as que já estavam abertas; usado pelos carregadores
+void GridMaze::setCellPassages(int id, bool up, bool right)
+{
+    int shift = (id & 3) * 2;
+    this->passages[id >> 2] |= (uint8_t)(((int)up | ((int)right << 1)) << shift);
+    this->version++;
+}
+
+// Interface de busca
+
+int GridMaze::getNodeCount()
+{
+    return this->width * this->height;
+}
+
+int GridMaze::getStartId()
+{
+    return this->getNodeCount() > 0 ? this->startId : -1;
+}
+
+bool GridMaze::isFinal(int id)
+{
+    return id == this->goalId;
+}
+
+// Distância euclidiana até o objetivo, calculada a partir das coordenadas da célula
+double GridMaze::getHeuristic(int id)
+{
+    return EuclideanHeuristic::estimate(this->getX(this->goalId) - this->getX(id),
+                                        this->getY(this->goalId) - this->getY(id));
+}
+
+// Gera as arestas da célula a partir dos bits de parede, em ordem de direção
+int GridMaze::getEdges(int id, Edge edges[4])
+{
+    int count = 0;
+    for (int direction = 0; direction < 4; direction++)
+    {
+        if (this->hasPassage(id, direction))
+        {
+            edges[count] = Edge(id, this->getNeighbourId(id, direction), 1);
+            edges[count].setDirection(direction);
+            count++;
+        }
+    }
+    return count;
+}
+
+// Toda passagem tem peso 1
+int GridMaze::getMaxIntegerWeight()
+{
+    return 1;
+}
+
+// Sempre uma grade de 4 vizinhos com custo 1 por passo (o Jump Point Search depende disso)
+bool GridMaze::isUniformGrid()
+{
+    return true;
+}
+
+#endif // GRIDMAZE_H
@@ -0,0 +1,83 @@
+/**************************************************************************************************
+ * Implementation of the heuristic policies
+ **************************************************************************************************/
+
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+using namespace std;
+
+// Heurísticas como políticas de template: cada uma dá a estimativa a partir das diferenças
+// inteiras de coordenadas entre o nó e o objetivo. Quem recebe a política como parâmetro
+// (QueryMaze, Graph::calculateHeuristics) chama estimate direto, sem string nem chamada
+// virtual, e o compilador a põe em linha no laço da busca.
+//
+// Uma heurística só garante o caminho ótimo no A* se nunca passa do custo real: a euclidiana
+// vale quando cada aresta custa pelo menos a distância entre os nós, a Manhattan em grades de
+// 4 vizinhos com custo 1 por passo e a octile também em grades de 8 vizinhos com diagonal
+// custando sqrt(2). A zero transforma o A* na busca de custo uniforme.
+struct EuclideanHeuristic
+{
+    static double estimate(int dx, int dy);
+};
+
+struct ManhattanHeuristic
+{
+    static double estimate(int dx, int dy);
+};
+
+struct OctileHeuristic
+{
+    static double estimate(int dx, int dy);
+};
+
+struct ZeroHeuristic
+{
+    static double estimate(int dx, int dy);
+};
+
+double EuclideanHeuristic::estimate(int dx, int dy)
+{
+    return sqrt((double)dx * dx + (double)dy * dy);
+}
+
+double ManhattanHeuristic::estimate(int dx, int dy)
+{
+    return (double)abs(dx) + abs(dy);
+}
+
+// Passos em diagonal enquanto as duas diferenças andam juntas, o resto em linha reta
+double OctileHeuristic::estimate(int dx, int dy)
+{
+    int ax = abs(dx);
+    int ay = abs(dy);
+    return max(ax, ay) + (M_SQRT2 - 1) * min(ax, ay);
+}
+
+double ZeroHeuristic::estimate(int, int)
+{
+    return 0;
+}
+
+// Política com que o labirinto calcula getHeuristic: a que ele declara em HeuristicPolicy
+// (QueryMaze) ou, se não declara, a euclidiana, que é a dos demais. Quem precisa estimar
+// outra distância no mesmo labirinto (a metade do A* bidirecional que parte do objetivo) usa
+// a mesma política
+template <class Maze, class = void>
+struct MazeHeuristic
+{
+    typedef EuclideanHeuristic type;
+};
+
+template <class Maze>
+struct MazeHeuristic<Maze, void_t<typename Maze::HeuristicPolicy>>
+{
+    typedef typename Maze::HeuristicPolicy type;
+};
+
+#endif // HEURISTIC_H
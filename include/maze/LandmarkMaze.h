@@ -0,0 +1,124 @@
+/**************************************************************************************************
+ * Implementation of the TAD LandmarkMaze
+ **************************************************************************************************/
+
+#ifndef LANDMARKMAZE_H
+#define LANDMARKMAZE_H
+
+#include "Edge.h"
+#include "LandmarkTable.h"
+
+using namespace std;
+
+// Visão de um labirinto para uma consulta entre dois nós, como o QueryMaze, mas com a
+// heurística ALT da tabela de marcos no lugar da distância euclidiana. A tabela é montada uma
+// vez e compartilhada, só lida, por todas as consultas no mesmo labirinto.
+template <class Maze>
+class LandmarkMaze
+{
+
+private:
+    Maze *maze;
+    LandmarkTable *table;
+    int startId;
+    int goalId;
+
+public:
+    LandmarkMaze(Maze *maze, LandmarkTable *table, int startId, int goalId);
+    ~LandmarkMaze();
+
+    // Interface usada pelas buscas da árvore
+    int getNodeCount();
+    int getStartId();
+    int getGoalId();
+    int getX(int id);
+    int getY(int id);
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    unsigned long long getVersion();
+};
+
+// Construtor
+template <class Maze>
+LandmarkMaze<Maze>::LandmarkMaze(Maze *maze, LandmarkTable *table, int startId, int goalId)
+{
+    this->maze = maze;
+    this->table = table;
+    this->startId = startId;
+    this->goalId = goalId;
+}
+
+// Destrutor
+template <class Maze>
+LandmarkMaze<Maze>::~LandmarkMaze()
+{
+    this->maze = nullptr;
+    this->table = nullptr;
+}
+
+// Interface de busca
+
+template <class Maze>
+int LandmarkMaze<Maze>::getNodeCount()
+{
+    return this->maze->getNodeCount();
+}
+
+template <class Maze>
+int LandmarkMaze<Maze>::getStartId()
+{
+    return this->startId;
+}
+
+template <class Maze>
+int LandmarkMaze<Maze>::getGoalId()
+{
+    return this->goalId;
+}
+
+template <class Maze>
+int LandmarkMaze<Maze>::getX(int id)
+{
+    return this->maze->getX(id);
+}
+
+template <class Maze>
+int LandmarkMaze<Maze>::getY(int id)
+{
+    return this->maze->getY(id);
+}
+
+template <class Maze>
+bool LandmarkMaze<Maze>::isFinal(int id)
+{
+    return id == this->goalId;
+}
+
+template <class Maze>
+double LandmarkMaze<Maze>::getHeuristic(int id)
+{
+    return this->table->getLowerBound(id, this->goalId);
+}
+
+template <class Maze>
+int LandmarkMaze<Maze>::getEdges(int id, Edge edges[4])
+{
+    return this->maze->getEdges(id, edges);
+}
+
+template <class Maze>
+int LandmarkMaze<Maze>::getMaxIntegerWeight()
+{
+    return this->maze->getMaxIntegerWeight();
+}
+
+// Versão do labirinto original (a tabela de marcos precisa ser remontada se ele mudar)
+template <class Maze>
+unsigned long long LandmarkMaze<Maze>::getVersion()
+{
+    return this->maze->getVersion();
+}
+
+#endif // LANDMARKMAZE_H
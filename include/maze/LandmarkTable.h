@@ -0,0 +1,190 @@
+/**************************************************************************************************
+ * Implementation of the TAD LandmarkTable
+ **************************************************************************************************/
+
+#ifndef LANDMARKTABLE_H
+#define LANDMARKTABLE_H
+
+#include <cmath>
+#include <vector>
+
+#include "Edge.h"
+#include "../perf/perf.h"
+#include "../tree/IndexedHeap.h"
+
+using namespace std;
+
+// Distâncias exatas de k marcos (landmarks) até todos os nós, para a heurística ALT: pela
+// desigualdade triangular, |d(marco, objetivo) - d(marco, nó)| nunca passa da distância do nó
+// ao objetivo, e a heurística é o maior desses limites entre os marcos.
+//
+// Os marcos são escolhidos pelo ponto mais distante: o primeiro é o nó mais longe do início e
+// cada um dos seguintes é o nó mais longe de todos os marcos já escolhidos.
+//
+// A tabela é um vetor de float por nó, com os k marcos lado a lado e completado com zeros até
+// um múltiplo de 8, então o máximo sobre os marcos é um laço contíguo que o compilador
+// vetoriza. Nós que um marco não alcança ficam com 0: o nó e o objetivo ou estão na mesma
+// componente (e o limite dá 0) ou não há caminho. Pesos inteiros são exatos até 2^24.
+class LandmarkTable
+{
+
+private:
+    vector<float> distances; // distances[id * stride + marco]
+    vector<int> landmarks;
+    int stride;
+    double elapsedTime;
+
+    template <class Maze>
+    void computeDistances(Maze *maze, int sourceId, vector<double> &result);
+
+public:
+    LandmarkTable();
+    ~LandmarkTable();
+
+    // Operations
+    template <class Maze>
+    void build(Maze *maze, int landmarkCount);
+    double getLowerBound(int id, int goalId);
+
+    // Getters
+    int getLandmarkCount();
+    int getLandmark(int index);
+    size_t getMemoryUsage();
+    double getElapsedTime();
+};
+
+// Construtor
+LandmarkTable::LandmarkTable()
+{
+    this->stride = 0;
+    this->elapsedTime = 0;
+}
+
+// Destrutor
+LandmarkTable::~LandmarkTable()
+{
+    this->stride = 0;
+}
+
+// Dijkstra a partir de sourceId até todos os nós; infinito nos que não são alcançados
+template <class Maze>
+void LandmarkTable::computeDistances(Maze *maze, int sourceId, vector<double> &result)
+{
+    int nodeCount = maze->getNodeCount();
+    result.assign(nodeCount, INFINITY);
+
+    IndexedHeap openList;
+    openList.reset(nodeCount);
+    result[sourceId] = 0;
+    openList.push(sourceId, 0, 0);
+
+    Edge edges[4];
+    while (!openList.isEmpty())
+    {
+        int id, value;
+        openList.pop(id, value);
+
+        int numEdges = maze->getEdges(id, edges);
+        for (int i = 0; i < numEdges; i++)
+        {
+            int targetId = edges[i].getTargetId();
+            double cost = result[id] + edges[i].getWeight();
+            if (cost >= result[targetId])
+                continue;
+
+            bool open = openList.contains(targetId);
+            result[targetId] = cost;
+            if (open)
+                openList.decrease(targetId, cost, 0);
+            else
+                openList.push(targetId, cost, 0);
+        }
+    }
+}
+
+template <class Maze>
+void LandmarkTable::build(Maze *maze, int landmarkCount)
+{
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    int nodeCount = maze->getNodeCount();
+    this->landmarks.clear();
+    this->stride = (landmarkCount + 7) / 8 * 8;
+    this->distances.assign((size_t)nodeCount * this->stride, 0.0f);
+    if (nodeCount == 0 || landmarkCount <= 0)
+    {
+        this->stride = 0;
+        return;
+    }
+
+    // Menor distância de cada nó até os marcos escolhidos; começa pela distância ao início
+    vector<double> nearest;
+    vector<double> result;
+    int startId = maze->getStartId() >= 0 ? maze->getStartId() : 0;
+    this->computeDistances(maze, startId, nearest);
+
+    for (int index = 0; index < landmarkCount; index++)
+    {
+        int farthestId = -1;
+        for (int id = 0; id < nodeCount; id++)
+            if (nearest[id] != INFINITY && (farthestId < 0 || nearest[id] > nearest[farthestId]))
+                farthestId = id;
+
+        // Todos os nós alcançáveis já são marcos
+        if (farthestId < 0 || (index > 0 && nearest[farthestId] == 0))
+            break;
+
+        this->landmarks.push_back(farthestId);
+        this->computeDistances(maze, farthestId, result);
+        for (int id = 0; id < nodeCount; id++)
+        {
+            if (result[id] == INFINITY)
+                continue;
+            this->distances[(size_t)id * this->stride + index] = (float)result[id];
+            nearest[id] = index == 0 ? result[id] : min(nearest[id], result[id]);
+        }
+    }
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+}
+
+// Maior limite inferior da distância de id até goalId entre os marcos
+double LandmarkTable::getLowerBound(int id, int goalId)
+{
+    const float *row = this->distances.data() + (size_t)id * this->stride;
+    const float *goalRow = this->distances.data() + (size_t)goalId * this->stride;
+
+    float bound = 0;
+    for (int i = 0; i < this->stride; i++)
+    {
+        float difference = fabsf(goalRow[i] - row[i]);
+        bound = difference > bound ? difference : bound;
+    }
+    return bound;
+}
+
+// Getters
+int LandmarkTable::getLandmarkCount()
+{
+    return (int)this->landmarks.size();
+}
+
+int LandmarkTable::getLandmark(int index)
+{
+    return this->landmarks[index];
+}
+
+size_t LandmarkTable::getMemoryUsage()
+{
+    return this->distances.size() * sizeof(float);
+}
+
+// Tempo da escolha dos marcos e das distâncias, em segundos
+double LandmarkTable::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+#endif // LANDMARKTABLE_H
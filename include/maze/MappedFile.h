@@ -0,0 +1,87 @@
+/**************************************************************************************************
+ * Implementation of the TAD MappedFile
+ **************************************************************************************************/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Arquivo mapeado somente para leitura. O mapeamento é compartilhado (MAP_SHARED), então
+// vários processos que mapeiam o mesmo arquivo usam as mesmas páginas do cache do sistema.
+class MappedFile
+{
+
+private:
+    int descriptor;
+    const char *data;
+    size_t size;
+
+public:
+    MappedFile(const char *path);
+    ~MappedFile();
+
+    // Getters
+    bool isOpen();
+    const char *getData();
+    size_t getSize();
+};
+
+// Construtor
+MappedFile::MappedFile(const char *path)
+{
+    this->data = nullptr;
+    this->size = 0;
+    this->descriptor = open(path, O_RDONLY);
+    if (this->descriptor < 0)
+        return;
+
+    struct stat info;
+    if (fstat(this->descriptor, &info) != 0 || info.st_size == 0)
+        return;
+
+    void *address = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, this->descriptor, 0);
+    if (address == MAP_FAILED)
+        return;
+
+    // Leitura sequencial: pede ao kernel para antecipar as próximas páginas
+    madvise(address, info.st_size, MADV_SEQUENTIAL);
+
+    this->data = (const char *)address;
+    this->size = info.st_size;
+}
+
+// Destrutor
+MappedFile::~MappedFile()
+{
+    if (this->data != nullptr)
+        munmap((void *)this->data, this->size);
+    if (this->descriptor >= 0)
+        close(this->descriptor);
+
+    this->data = nullptr;
+    this->size = 0;
+    this->descriptor = -1;
+}
+
+// Getters
+bool MappedFile::isOpen()
+{
+    return this->data != nullptr;
+}
+
+const char *MappedFile::getData()
+{
+    return this->data;
+}
+
+size_t MappedFile::getSize()
+{
+    return this->size;
+}
+
+#endif // MAPPEDFILE_H
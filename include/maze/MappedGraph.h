@@ -0,0 +1,338 @@
+/**************************************************************************************************
+ * Implementation of the TAD MappedGraph
+ **************************************************************************************************/
+
+#ifndef MAPPEDGRAPH_H
+#define MAPPEDGRAPH_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "Graph.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// Formato binário do grafo: um cabeçalho seguido de vetores de largura fixa, cada um
+// alinhado em 8 bytes. O arquivo é usado direto do mapeamento, sem leitura nem cópia;
+// mapeado de /dev/shm, vários processos compartilham a mesma cópia do labirinto.
+//
+//   tags        uint8  [nós]       NodeTag de cada nó
+//   coordinates int32  [nós * 2]   x, y
+//   heuristics  double [nós]
+//   edgeOffsets uint32 [nós + 1]   arestas do nó i em [edgeOffsets[i], edgeOffsets[i + 1])
+//   targets     int32  [arestas]
+//   directions  int8   [arestas]
+//   weights     double [arestas]
+struct MazeFileHeader
+{
+    char magic[8];     // "MAZEBIN"
+    uint32_t version;  // MAZE_FILE_VERSION
+    uint32_t weightBound; // Maior peso + 1 se todos forem inteiros não negativos; 0 se não (ou desconhecido)
+    uint32_t flags;    // MAZE_FILE_UNIFORM_GRID
+    uint32_t reserved;
+    int64_t nodeCount;
+    int64_t edgeCount;
+    int64_t startId;
+    int64_t goalId;
+    uint64_t tagsOffset;
+    uint64_t coordinatesOffset;
+    uint64_t heuristicsOffset;
+    uint64_t edgeOffsetsOffset;
+    uint64_t targetsOffset;
+    uint64_t directionsOffset;
+    uint64_t weightsOffset;
+    uint64_t fileSize;
+};
+
+const char MAZE_FILE_MAGIC[8] = "MAZEBIN";
+const uint32_t MAZE_FILE_VERSION = 3;
+const uint32_t MAZE_FILE_UNIFORM_GRID = 1; // Graph::isUniformGrid no grafo gravado
+
+class MappedGraph
+{
+
+private:
+    MappedFile file;
+    MazeFileHeader *header;
+    const uint8_t *tags;
+    const int32_t *coordinates;
+    const double *heuristics;
+    const uint32_t *edgeOffsets;
+    const int32_t *targets;
+    const int8_t *directions;
+    const double *weights;
+
+    static uint64_t align(uint64_t offset);
+    static bool isValidSection(MazeFileHeader *header, uint64_t offset, int64_t count, uint64_t elementSize);
+
+public:
+    MappedGraph(const char *path);
+    ~MappedGraph();
+
+    static bool isMazeFile(const char *path);
+    static bool save(Graph *graph, const char *path);
+
+    // Getters
+    bool isOpen();
+    int getEdgeCount();
+    int getX(int id);
+    int getY(int id);
+    unsigned long long getVersion();
+
+    // Interface usada pelas buscas da árvore (a mesma de Graph e GridMaze)
+    int getNodeCount();
+    int getStartId();
+    int getGoalId();
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    bool isUniformGrid();
+};
+
+uint64_t MappedGraph::align(uint64_t offset)
+{
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+// A seção começa alinhada em 8 bytes e seus count elementos cabem no arquivo
+bool MappedGraph::isValidSection(MazeFileHeader *header, uint64_t offset, int64_t count, uint64_t elementSize)
+{
+    if (offset % 8 != 0 || offset < sizeof(MazeFileHeader) || offset > header->fileSize)
+        return false;
+
+    // count vem validado (menos de 2^33) e elementSize é no máximo 8, então não estoura
+    return (uint64_t)count * elementSize <= header->fileSize - offset;
+}
+
+// Construtor: valida o cabeçalho e aponta os vetores para dentro do mapeamento. O arquivo pode
+// vir de outro processo, então nenhum ponteiro é montado antes de conferir que a contagem, o
+// alinhamento e o tamanho de cada seção cabem no arquivo. Depois uma passada pelas arestas
+// confere que os deslocamentos não diminuem e que cada destino é um nó, porque as buscas
+// indexam seus vetores com eles
+MappedGraph::MappedGraph(const char *path) : file(path)
+{
+    this->header = nullptr;
+    if (!this->file.isOpen() || this->file.getSize() < sizeof(MazeFileHeader))
+        return;
+
+    MazeFileHeader *candidate = (MazeFileHeader *)this->file.getData();
+    if (memcmp(candidate->magic, MAZE_FILE_MAGIC, 8) != 0 || candidate->version != MAZE_FILE_VERSION ||
+        candidate->fileSize != this->file.getSize())
+        return;
+
+    int64_t nodeCount = candidate->nodeCount;
+    int64_t edgeCount = candidate->edgeCount;
+    if (nodeCount < 0 || nodeCount > INT32_MAX || edgeCount < 0 || edgeCount > INT32_MAX)
+        return;
+    if (candidate->startId < (nodeCount > 0 ? 0 : -1) || candidate->startId >= nodeCount ||
+        candidate->goalId < -1 || candidate->goalId >= nodeCount)
+        return;
+
+    if (!isValidSection(candidate, candidate->tagsOffset, nodeCount, sizeof(uint8_t)) ||
+        !isValidSection(candidate, candidate->coordinatesOffset, nodeCount * 2, sizeof(int32_t)) ||
+        !isValidSection(candidate, candidate->heuristicsOffset, nodeCount, sizeof(double)) ||
+        !isValidSection(candidate, candidate->edgeOffsetsOffset, nodeCount + 1, sizeof(uint32_t)) ||
+        !isValidSection(candidate, candidate->targetsOffset, edgeCount, sizeof(int32_t)) ||
+        !isValidSection(candidate, candidate->directionsOffset, edgeCount, sizeof(int8_t)) ||
+        !isValidSection(candidate, candidate->weightsOffset, edgeCount, sizeof(double)))
+        return;
+
+    const char *base = this->file.getData();
+    this->tags = (const uint8_t *)(base + candidate->tagsOffset);
+    this->coordinates = (const int32_t *)(base + candidate->coordinatesOffset);
+    this->heuristics = (const double *)(base + candidate->heuristicsOffset);
+    this->edgeOffsets = (const uint32_t *)(base + candidate->edgeOffsetsOffset);
+    this->targets = (const int32_t *)(base + candidate->targetsOffset);
+    this->directions = (const int8_t *)(base + candidate->directionsOffset);
+    this->weights = (const double *)(base + candidate->weightsOffset);
+
+    if (this->edgeOffsets[0] != 0 || this->edgeOffsets[nodeCount] != (uint64_t)edgeCount)
+        return;
+    for (int64_t id = 0; id < nodeCount; id++)
+        if (this->edgeOffsets[id] > this->edgeOffsets[id + 1])
+            return;
+    for (int64_t e = 0; e < edgeCount; e++)
+        if (this->targets[e] < 0 || this->targets[e] >= nodeCount || this->directions[e] < -1 || this->directions[e] > 3)
+            return;
+
+    this->header = candidate;
+}
+
+// Destrutor (o mapeamento é desfeito pelo MappedFile)
+MappedGraph::~MappedGraph()
+{
+    this->header = nullptr;
+}
+
+bool MappedGraph::isMazeFile(const char *path)
+{
+    MappedFile file(path);
+    return file.isOpen() && file.getSize() >= 8 && memcmp(file.getData(), MAZE_FILE_MAGIC, 8) == 0;
+}
+
+// Grava o grafo no formato binário
+bool MappedGraph::save(Graph *graph, const char *path)
+{
+    int64_t nodeCount = graph->getNodeCount();
+    int64_t edgeCount = graph->getEdgeCount();
+    if (nodeCount > INT32_MAX || edgeCount > INT32_MAX)
+        return false;
+
+    MazeFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAZE_FILE_MAGIC, 8);
+    header.version = MAZE_FILE_VERSION;
+    header.nodeCount = nodeCount;
+    header.edgeCount = edgeCount;
+    header.startId = graph->getStartId();
+    header.goalId = graph->getGoalId();
+    header.weightBound = (uint32_t)(graph->getMaxIntegerWeight() + 1);
+    header.flags = graph->isUniformGrid() ? MAZE_FILE_UNIFORM_GRID : 0;
+    header.tagsOffset = align(sizeof(MazeFileHeader));
+    header.coordinatesOffset = align(header.tagsOffset + nodeCount);
+    header.heuristicsOffset = align(header.coordinatesOffset + nodeCount * 2 * sizeof(int32_t));
+    header.edgeOffsetsOffset = align(header.heuristicsOffset + nodeCount * sizeof(double));
+    header.targetsOffset = align(header.edgeOffsetsOffset + (nodeCount + 1) * sizeof(uint32_t));
+    header.directionsOffset = align(header.targetsOffset + edgeCount * sizeof(int32_t));
+    header.weightsOffset = align(header.directionsOffset + edgeCount);
+    header.fileSize = header.weightsOffset + edgeCount * sizeof(double);
+
+    vector<uint8_t> tags(nodeCount);
+    vector<int32_t> coordinates(nodeCount * 2);
+    vector<double> heuristics(nodeCount);
+    vector<uint32_t> edgeOffsets(nodeCount + 1, 0);
+    vector<int32_t> targets;
+    vector<int8_t> directions;
+    vector<double> weights;
+    targets.reserve(edgeCount);
+    directions.reserve(edgeCount);
+    weights.reserve(edgeCount);
+
+    for (int id = 0; id < nodeCount; id++)
+    {
+        Node *node = graph->getNodeById(id);
+        tags[id] = node->getTag();
+        coordinates[2 * id] = node->getX();
+        coordinates[2 * id + 1] = node->getY();
+        heuristics[id] = node->getHeuristic();
+
+        for (Edge *edge = node->getFirstEdge(); edge != nullptr; edge = edge->getNextEdge())
+        {
+            targets.push_back(edge->getTargetId());
+            directions.push_back((int8_t)edge->getDirection());
+            weights.push_back(edge->getWeight());
+        }
+        edgeOffsets[id + 1] = (uint32_t)targets.size();
+    }
+
+    ofstream output(path, ios::binary | ios::trunc);
+    if (!output.is_open())
+        return false;
+
+    // Escreve cada seção na posição do cabeçalho, completando o alinhamento com zeros
+    auto writeSection = [&output](uint64_t offset, const void *data, uint64_t size)
+    {
+        static const char padding[8] = {0};
+        uint64_t position = (uint64_t)output.tellp();
+        output.write(padding, offset - position);
+        output.write((const char *)data, size);
+    };
+
+    output.write((const char *)&header, sizeof(header));
+    writeSection(header.tagsOffset, tags.data(), tags.size());
+    writeSection(header.coordinatesOffset, coordinates.data(), coordinates.size() * sizeof(int32_t));
+    writeSection(header.heuristicsOffset, heuristics.data(), heuristics.size() * sizeof(double));
+    writeSection(header.edgeOffsetsOffset, edgeOffsets.data(), edgeOffsets.size() * sizeof(uint32_t));
+    writeSection(header.targetsOffset, targets.data(), targets.size() * sizeof(int32_t));
+    writeSection(header.directionsOffset, directions.data(), directions.size());
+    writeSection(header.weightsOffset, weights.data(), weights.size() * sizeof(double));
+
+    return output.good();
+}
+
+// Getters
+bool MappedGraph::isOpen()
+{
+    return this->header != nullptr;
+}
+
+int MappedGraph::getEdgeCount()
+{
+    return this->header != nullptr ? (int)this->header->edgeCount : 0;
+}
+
+int MappedGraph::getX(int id)
+{
+    return this->coordinates[2 * id];
+}
+
+int MappedGraph::getY(int id)
+{
+    return this->coordinates[2 * id + 1];
+}
+
+// O arquivo mapeado é somente leitura, então a versão nunca muda
+unsigned long long MappedGraph::getVersion()
+{
+    return 0;
+}
+
+// Interface de busca
+
+int MappedGraph::getNodeCount()
+{
+    return this->header != nullptr ? (int)this->header->nodeCount : 0;
+}
+
+int MappedGraph::getStartId()
+{
+    return this->header != nullptr ? (int)this->header->startId : -1;
+}
+
+int MappedGraph::getGoalId()
+{
+    return this->header != nullptr ? (int)this->header->goalId : -1;
+}
+
+bool MappedGraph::isFinal(int id)
+{
+    return this->tags[id] == FINAL_NODE;
+}
+
+double MappedGraph::getHeuristic(int id)
+{
+    return this->heuristics[id];
+}
+
+int MappedGraph::getEdges(int id, Edge edges[4])
+{
+    uint32_t begin = this->edgeOffsets[id];
+    uint32_t end = this->edgeOffsets[id + 1];
+
+    int count = 0;
+    for (uint32_t e = begin; e < end && count < 4; e++)
+    {
+        edges[count] = Edge(id, this->targets[e], 0);
+        edges[count].setDirection(this->directions[e]);
+        edges[count].setWeight(this->weights[e]);
+        count++;
+    }
+    return count;
+}
+
+// Lido do cabeçalho, sem percorrer os pesos mapeados
+int MappedGraph::getMaxIntegerWeight()
+{
+    return this->header != nullptr ? (int)this->header->weightBound - 1 : -1;
+}
+
+bool MappedGraph::isUniformGrid()
+{
+    return this->header != nullptr && (this->header->flags & MAZE_FILE_UNIFORM_GRID) != 0;
+}
+
+#endif // MAPPEDGRAPH_H
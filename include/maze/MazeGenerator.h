@@ -0,0 +1,358 @@
+/**************************************************************************************************
+ * Implementation of the TAD MazeGenerator
+ **************************************************************************************************/
+
+#ifndef MAZEGENERATOR_H
+#define MAZEGENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GridMaze.h"
+#include "../perf/perf.h"
+
+using namespace std;
+
+// Algoritmos de geração disponíveis
+enum MazeAlgorithm
+{
+    BACKTRACKER, // Backtracking recursivo (DFS aleatória)
+    KRUSKAL,     // Kruskal aleatório
+    WILSON,      // Wilson (passeios aleatórios com apagamento de laços)
+    BRAID        // Backtracking + remoção de becos sem saída (labirinto com ciclos)
+};
+
+// Gerador determinístico de labirintos em grade: a mesma semente produz sempre o mesmo
+// labirinto. Os sorteios usam rng() % n em vez de uniform_int_distribution para que o
+// resultado não dependa da implementação da biblioteca padrão.
+class MazeGenerator
+{
+
+private:
+    mt19937_64 rng;
+    double braidProbability;      // Chance de abrir cada beco sem saída no modo BRAID
+    Perf::PerformanceTimer timer; // Tempo da última geração
+    long long generatedCells;     // Células da última geração
+
+    int randomInt(int n);
+    void markVisited(vector<uint64_t> &bits, int id);
+    bool isMarked(vector<uint64_t> &bits, int id);
+    int findRoot(vector<int> &parent, int id);
+
+public:
+    MazeGenerator(unsigned long long seed);
+    ~MazeGenerator();
+
+    GridMaze *generate(MazeAlgorithm algorithm, int width, int height);
+
+    // Algoritmos (o labirinto recebido deve estar com todas as paredes fechadas)
+    void recursiveBacktracker(GridMaze *maze);
+    void kruskal(GridMaze *maze);
+    void wilson(GridMaze *maze);
+    void braid(GridMaze *maze, double probability);
+
+    // Getters
+    double getElapsedTime();
+    double getCellsPerSecond();
+
+    // Setters
+    void setBraidProbability(double probability);
+
+    static bool parseAlgorithm(string name, MazeAlgorithm &algorithm);
+};
+
+// Construtor
+MazeGenerator::MazeGenerator(unsigned long long seed) : rng(seed)
+{
+    this->braidProbability = 0.5;
+    this->generatedCells = 0;
+}
+
+// Destrutor
+MazeGenerator::~MazeGenerator()
+{
+    this->generatedCells = 0;
+}
+
+int MazeGenerator::randomInt(int n)
+{
+    return (int)(this->rng() % (unsigned long long)n);
+}
+
+void MazeGenerator::markVisited(vector<uint64_t> &bits, int id)
+{
+    bits[id >> 6] |= (uint64_t)1 << (id & 63);
+}
+
+bool MazeGenerator::isMarked(vector<uint64_t> &bits, int id)
+{
+    return (bits[id >> 6] >> (id & 63)) & 1;
+}
+
+// Union-find com compressão de caminho por divisão ao meio
+int MazeGenerator::findRoot(vector<int> &parent, int id)
+{
+    while (parent[id] != id)
+    {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+    }
+    return id;
+}
+
+// Gera um labirinto novo com o algoritmo escolhido e mede a vazão da geração
+GridMaze *MazeGenerator::generate(MazeAlgorithm algorithm, int width, int height)
+{
+    GridMaze *maze = new GridMaze(width, height);
+
+    this->timer.start();
+
+    switch (algorithm)
+    {
+    case BACKTRACKER:
+        this->recursiveBacktracker(maze);
+        break;
+    case KRUSKAL:
+        this->kruskal(maze);
+        break;
+    case WILSON:
+        this->wilson(maze);
+        break;
+    case BRAID:
+        this->recursiveBacktracker(maze);
+        this->braid(maze, this->braidProbability);
+        break;
+    }
+
+    this->timer.stop();
+    this->generatedCells = (long long)width * height;
+
+    return maze;
+}
+
+// DFS aleatória com pilha explícita (não estoura a pilha de chamadas em labirintos grandes)
+void MazeGenerator::recursiveBacktracker(GridMaze *maze)
+{
+    int cellCount = maze->getNodeCount();
+    if (cellCount == 0)
+        return;
+
+    vector<uint64_t> visited((cellCount + 63) / 64, 0);
+    vector<int> pilha;
+
+    int start = this->randomInt(cellCount);
+    markVisited(visited, start);
+    pilha.push_back(start);
+
+    int directions[4];
+
+    while (!pilha.empty())
+    {
+        int current = pilha.back();
+
+        int count = 0;
+        for (int direction = 0; direction < 4; direction++)
+        {
+            int neighbourId = maze->getNeighbourId(current, direction);
+            if (neighbourId >= 0 && !isMarked(visited, neighbourId))
+                directions[count++] = direction;
+        }
+
+        if (count == 0)
+        {
+            pilha.pop_back();
+            continue;
+        }
+
+        int direction = directions[this->randomInt(count)];
+        int neighbourId = maze->getNeighbourId(current, direction);
+
+        maze->setPassage(current, direction, true);
+        markVisited(visited, neighbourId);
+        pilha.push_back(neighbourId);
+    }
+}
+
+// Embaralha todas as paredes internas e abre as que ligam componentes diferentes
+void MazeGenerator::kruskal(GridMaze *maze)
+{
+    int cellCount = maze->getNodeCount();
+
+    // Parede codificada como id * 2 + (0 -> cima, 1 -> direita)
+    vector<uint32_t> walls;
+    walls.reserve((size_t)cellCount * 2);
+    for (int id = 0; id < cellCount; id++)
+    {
+        if (maze->getNeighbourId(id, 0) >= 0)
+            walls.push_back((uint32_t)id * 2);
+        if (maze->getNeighbourId(id, 3) >= 0)
+            walls.push_back((uint32_t)id * 2 + 1);
+    }
+
+    // Fisher-Yates
+    for (int i = (int)walls.size() - 1; i > 0; i--)
+        swap(walls[i], walls[this->randomInt(i + 1)]);
+
+    vector<int> parent(cellCount);
+    vector<int> size(cellCount, 1);
+    for (int id = 0; id < cellCount; id++)
+        parent[id] = id;
+
+    int openedWalls = 0;
+    for (uint32_t wall : walls)
+    {
+        int id = (int)(wall >> 1);
+        int direction = (wall & 1) ? 3 : 0;
+
+        int rootA = this->findRoot(parent, id);
+        int rootB = this->findRoot(parent, maze->getNeighbourId(id, direction));
+        if (rootA == rootB)
+            continue;
+
+        if (size[rootA] < size[rootB])
+            swap(rootA, rootB);
+        parent[rootB] = rootA;
+        size[rootA] += size[rootB];
+
+        maze->setPassage(id, direction, true);
+
+        // Árvore geradora completa
+        if (++openedWalls == cellCount - 1)
+            break;
+    }
+}
+
+// Passeios aleatórios até a árvore; guardar só a última direção de cada célula apaga os laços
+void MazeGenerator::wilson(GridMaze *maze)
+{
+    int cellCount = maze->getNodeCount();
+    if (cellCount == 0)
+        return;
+
+    vector<uint64_t> inMaze((cellCount + 63) / 64, 0);
+    vector<uint8_t> walkDirection(cellCount, 0);
+
+    markVisited(inMaze, this->randomInt(cellCount));
+
+    int directions[4];
+
+    for (int cell = 0; cell < cellCount; cell++)
+    {
+        if (isMarked(inMaze, cell))
+            continue;
+
+        // Passeio aleatório até encontrar uma célula do labirinto
+        int current = cell;
+        while (!isMarked(inMaze, current))
+        {
+            int count = 0;
+            for (int direction = 0; direction < 4; direction++)
+            {
+                if (maze->getNeighbourId(current, direction) >= 0)
+                    directions[count++] = direction;
+            }
+
+            int direction = directions[this->randomInt(count)];
+            walkDirection[current] = (uint8_t)direction;
+            current = maze->getNeighbourId(current, direction);
+        }
+
+        // Refaz o passeio sem laços, abrindo as passagens
+        current = cell;
+        while (!isMarked(inMaze, current))
+        {
+            int direction = walkDirection[current];
+            maze->setPassage(current, direction, true);
+            markVisited(inMaze, current);
+            current = maze->getNeighbourId(current, direction);
+        }
+    }
+}
+
+// Abre uma parede extra em cada beco sem saída com a probabilidade dada, criando ciclos.
+// Prefere ligar o beco a outro beco, o que remove dois de uma vez.
+void MazeGenerator::braid(GridMaze *maze, double probability)
+{
+    int cellCount = maze->getNodeCount();
+
+    int closed[4];
+    int closedDeadEnds[4];
+
+    for (int id = 0; id < cellCount; id++)
+    {
+        int passages = 0;
+        int count = 0;
+        int deadEndCount = 0;
+
+        for (int direction = 0; direction < 4; direction++)
+        {
+            if (maze->hasPassage(id, direction))
+            {
+                passages++;
+                continue;
+            }
+
+            int neighbourId = maze->getNeighbourId(id, direction);
+            if (neighbourId < 0)
+                continue;
+
+            closed[count++] = direction;
+
+            int neighbourPassages = 0;
+            for (int d = 0; d < 4; d++)
+                neighbourPassages += maze->hasPassage(neighbourId, d);
+            if (neighbourPassages == 1)
+                closedDeadEnds[deadEndCount++] = direction;
+        }
+
+        // 53 bits aleatórios -> valor uniforme em [0, 1)
+        double draw = (this->rng() >> 11) * (1.0 / 9007199254740992.0);
+        if (passages != 1 || count == 0 || draw >= probability)
+            continue;
+
+        int direction = deadEndCount > 0 ? closedDeadEnds[this->randomInt(deadEndCount)]
+                                         : closed[this->randomInt(count)];
+        maze->setPassage(id, direction, true);
+    }
+}
+
+// Getters
+double MazeGenerator::getElapsedTime()
+{
+    return this->timer.elapsed_time();
+}
+
+double MazeGenerator::getCellsPerSecond()
+{
+    double elapsed = this->timer.elapsed_time();
+    if (elapsed <= 0)
+        return 0;
+    return this->generatedCells / elapsed;
+}
+
+// Setters
+void MazeGenerator::setBraidProbability(double probability)
+{
+    this->braidProbability = probability;
+}
+
+bool MazeGenerator::parseAlgorithm(string name, MazeAlgorithm &algorithm)
+{
+    if (name == "backtracker")
+        algorithm = BACKTRACKER;
+    else if (name == "kruskal")
+        algorithm = KRUSKAL;
+    else if (name == "wilson")
+        algorithm = WILSON;
+    else if (name == "braid")
+        algorithm = BRAID;
+    else
+        return false;
+
+    return true;
+}
+
+#endif // MAZEGENERATOR_H
@@ -0,0 +1,257 @@
+/**************************************************************************************************
+ * Implementation of the TAD MazeLoader
+ **************************************************************************************************/
+
+#ifndef MAZELOADER_H
+#define MAZELOADER_H
+
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include "Graph.h"
+#include "GridMaze.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// Leitura de labirintos em texto direto do arquivo mapeado em memória, sem iostream.
+//
+// Grade ASCII: uma linha por fileira, de cima para baixo. '#' é parede, '.' é célula livre,
+// 'S' é o início e 'G' o objetivo. Linhas mais curtas são completadas com paredes.
+//
+// Lista de arestas (arestas não direcionadas, inseridas nos dois sentidos):
+//   <nós> <arestas> <id inicial> <id final>
+//   <x> <y>                                  (uma linha por nó, na ordem dos ids)
+//   <origem> <destino> <direção> <peso>      (uma linha por aresta)
+// A direção vai de -1 (sem direção) a 3, o peso não pode ser negativo e cada nó tem no
+// máximo 4 arestas, como nos demais labirintos; fora disso o arquivo é recusado.
+class MazeLoader
+{
+
+private:
+    static const bool *getOpenCellTable();
+    static bool parseInt(const char *&cursor, const char *end, long long &value);
+
+public:
+    static bool isEdgeList(const char *path);
+    static GridMaze *loadAsciiGrid(const char *path);
+    static bool loadEdgeList(const char *path, Graph *graph);
+};
+
+// Tabela indexada pelo caractere: evita desvios que o preditor erraria em grades aleatórias
+const bool *MazeLoader::getOpenCellTable()
+{
+    static bool table[256] = {false};
+    static bool initialized = false;
+    if (!initialized)
+    {
+        table[(unsigned char)'.'] = true;
+        table[(unsigned char)'S'] = true;
+        table[(unsigned char)'G'] = true;
+        initialized = true;
+    }
+    return table;
+}
+
+// Lê o próximo inteiro (com sinal) pulando espaços e quebras de linha; falha se ele não cabe
+// em um int
+bool MazeLoader::parseInt(const char *&cursor, const char *end, long long &value)
+{
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+        cursor++;
+
+    bool negative = false;
+    if (cursor < end && *cursor == '-')
+    {
+        negative = true;
+        cursor++;
+    }
+
+    if (cursor >= end || *cursor < '0' || *cursor > '9')
+        return false;
+
+    long long number = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9')
+    {
+        number = number * 10 + (*cursor++ - '0');
+        if (number > INT_MAX)
+            return false;
+    }
+
+    value = negative ? -number : number;
+    return true;
+}
+
+// A lista de arestas começa com um número; a grade começa com um caractere de célula
+bool MazeLoader::isEdgeList(const char *path)
+{
+    MappedFile file(path);
+    if (!file.isOpen())
+        return false;
+
+    const char *cursor = file.getData();
+    const char *end = cursor + file.getSize();
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+        cursor++;
+
+    return cursor < end && *cursor >= '0' && *cursor <= '9';
+}
+
+// Monta um GridMaze com as mesmas dimensões do texto; cada célula livre ganha passagem para
+// as vizinhas livres e as paredes ficam isoladas. A única varredura extra é um memchr para
+// contar as linhas, necessário porque o y cresce para cima e a primeira linha é a do topo.
+GridMaze *MazeLoader::loadAsciiGrid(const char *path)
+{
+    MappedFile file(path);
+    if (!file.isOpen())
+        return nullptr;
+
+    const char *data = file.getData();
+    const char *end = data + file.getSize();
+
+    // Dimensões
+    int height = 0;
+    int width = 0;
+    for (const char *line = data; line < end;)
+    {
+        const char *newline = (const char *)memchr(line, '\n', end - line);
+        const char *lineEnd = newline != nullptr ? newline : end;
+        int length = (int)(lineEnd - line);
+        if (length > 0 && line[length - 1] == '\r')
+            length--;
+
+        if (length > 0)
+        {
+            height++;
+            if (length > width)
+                width = length;
+        }
+        line = lineEnd + 1;
+    }
+
+    if (width == 0 || height == 0)
+        return nullptr;
+
+    GridMaze *maze = new GridMaze(width, height);
+
+    // Uma passada pelo texto; a linha anterior (acima) é lida direto do mapeamento
+    const bool *openCell = getOpenCellTable();
+    const char *previousLine = nullptr;
+    int previousLength = 0;
+    int row = 0;
+
+    for (const char *line = data; line < end;)
+    {
+        const char *newline = (const char *)memchr(line, '\n', end - line);
+        const char *lineEnd = newline != nullptr ? newline : end;
+        int length = (int)(lineEnd - line);
+        if (length > 0 && line[length - 1] == '\r')
+            length--;
+
+        if (length > 0)
+        {
+            int y = height - 1 - row;
+            int rowStart = y * width;
+
+            // Laço sem desvios dependentes do conteúdo: em labirintos grandes as células livres
+            // e paredes se alternam de forma imprevisível para o preditor de desvios
+            int aboveLength = previousLine != nullptr ? min(length, previousLength) : 0;
+            bool open = openCell[(unsigned char)line[0]];
+
+            for (int x = 0; x < length; x++)
+            {
+                bool nextOpen = x + 1 < length ? openCell[(unsigned char)line[x + 1]] : false;
+                bool up = x < aboveLength ? openCell[(unsigned char)previousLine[x]] : false;
+                maze->setCellPassages(rowStart + x, open & up, open & nextOpen);
+
+                char c = line[x];
+                if ((c == 'S') | (c == 'G'))
+                {
+                    if (c == 'S')
+                        maze->setStart(rowStart + x);
+                    else
+                        maze->setGoal(rowStart + x);
+                }
+                open = nextOpen;
+            }
+
+            previousLine = line;
+            previousLength = length;
+            row++;
+        }
+        line = lineEnd + 1;
+    }
+
+    return maze;
+}
+
+// Monta o grafo direto no armazenamento pré-alocado a partir do cabeçalho
+bool MazeLoader::loadEdgeList(const char *path, Graph *graph)
+{
+    MappedFile file(path);
+    if (!file.isOpen())
+        return false;
+
+    const char *cursor = file.getData();
+    const char *end = cursor + file.getSize();
+
+    long long nodeCount, edgeCount, startId, goalId;
+    if (!parseInt(cursor, end, nodeCount) || !parseInt(cursor, end, edgeCount) ||
+        !parseInt(cursor, end, startId) || !parseInt(cursor, end, goalId))
+        return false;
+
+    if (nodeCount <= 0 || edgeCount < 0 || startId < 0 || startId >= nodeCount || goalId < 0 || goalId >= nodeCount)
+        return false;
+
+    // Cada linha de nó tem pelo menos 4 bytes ("x y\n") e cada linha de aresta pelo menos 8; um
+    // cabeçalho que o arquivo não comporta é recusado antes de reservar a memória
+    int firstId = graph->getNodeIdCounter();
+    if (nodeCount * 4 + edgeCount * 8 > (long long)file.getSize() || nodeCount > INT_MAX - firstId ||
+        edgeCount > (INT_MAX - graph->getEdgeCount()) / 2)
+        return false;
+
+    graph->reserve(firstId + (int)nodeCount, graph->getEdgeCount() + 2 * (int)edgeCount);
+
+    for (long long id = 0; id < nodeCount; id++)
+    {
+        long long x, y;
+        if (!parseInt(cursor, end, x) || !parseInt(cursor, end, y))
+            return false;
+
+        NodeTag tag = INTERMEDIATE_NODE;
+        if (id == startId)
+            tag = INITIAL_NODE;
+        else if (id == goalId)
+            tag = FINAL_NODE;
+
+        graph->insertNode(tag, (int)x, (int)y, 0);
+    }
+
+    // Heurística até o objetivo, que só é conhecido depois de ler todas as posições
+    graph->calculateHeuristics(firstId + (int)goalId);
+
+    // Arestas de cada nó, contando os dois sentidos: getEdges só devolve as 4 primeiras
+    vector<int> degrees(nodeCount, 0);
+    for (long long i = 0; i < edgeCount; i++)
+    {
+        long long source, target, direction, weight;
+        if (!parseInt(cursor, end, source) || !parseInt(cursor, end, target) ||
+            !parseInt(cursor, end, direction) || !parseInt(cursor, end, weight))
+            return false;
+
+        if (source < 0 || source >= nodeCount || target < 0 || target >= nodeCount)
+            return false;
+        if (direction < -1 || direction > 3 || weight < 0)
+            return false;
+        if (++degrees[source] > 4 || ++degrees[target] > 4)
+            return false;
+
+        graph->insertEdge(firstId + (int)source, firstId + (int)target, (int)direction, (double)weight);
+    }
+
+    graph->finalize();
+    return true;
+}
+
+#endif // MAZELOADER_H
@@ -10,21 +10,29 @@
 
 using namespace std;
 
+// Tipo do nó no labirinto
+enum NodeTag : unsigned char
+{
+    INITIAL_NODE,      // inicial
+    INTERMEDIATE_NODE, // intermediário
+    FINAL_NODE         // final
+};
+
 class Node
 {
 
 private:
     int id;
-    Node *nextNode;
-    Edge *firstEdge;
-    Edge *lastEdge;
-    string tag;       // Tag -> (intermediário ou final)
-    bool visited;     // Flag para saber se foi visitado
-    string position;  // Posição do nó no grafo
+    Node *nextNode;   // Próximo nó no vetor de nós do grafo
+    Edge *firstEdge;  // Primeira aresta do nó no vetor CSR (não é dono)
+    Edge *lastEdge;   // Última aresta do nó no vetor CSR (não é dono)
+    NodeTag tag;      // Tag -> (inicial, intermediário ou final)
+    int x;            // Posição do nó no grafo (coluna)
+    int y;            // Posição do nó no grafo (linha)
     double heuristic; // Heurística do nó
 
 public:
-    Node(int id, string tag, string position, double heuristic);
+    Node(int id, NodeTag tag, int x, int y, double heuristic);
     ~Node();
 
     // Getters
@@ -32,51 +40,42 @@ public:
     Node *getNextNode();
     Edge *getFirstEdge();
     Edge *getLastEdge();
-    string getTag();
-    int getVisited();
-    string getPosition();
+    NodeTag getTag();
+    bool isFinal();
+    int getX();
+    int getY();
     double getHeuristic();
 
     // Setters
     void setNextNode(Node *node);
-    void setVisited();
-
-    void insertEdge(int sourceId, int targetId, int direction, double weight);
+    void setEdges(Edge *firstEdge, Edge *lastEdge);
+    void setHeuristic(double heuristic);
 
 };
 
 // Construtor
-Node::Node(int id, string tag, string position, double heuristic)
+Node::Node(int id, NodeTag tag, int x, int y, double heuristic)
 {
     this->id = id;
-    this->visited = false;
     this->firstEdge = nullptr;
+    this->lastEdge = nullptr;
     this->nextNode = nullptr;
     this->tag = tag;
-    this->position = position;
+    this->x = x;
+    this->y = y;
     this->heuristic = heuristic;
 
     // cout << "Node " << this->id << " -> " << this->heuristic << endl;
 };
 
 // Destrutor
+// As arestas pertencem ao vetor CSR do grafo, então o nó não as libera
 Node::~Node()
 {
-    Edge *nextEdge = this->firstEdge;
-
-    while (nextEdge != nullptr)
-    {
-        Edge *auxEdge = nextEdge->getNextEdge();
-        delete nextEdge;
-        nextEdge = auxEdge;
-    }
-
     this->id = -1;
-    this->visited = false;
     this->firstEdge = nullptr;
+    this->lastEdge = nullptr;
     this->nextNode = nullptr;
-    this->tag = " ";
-    this->position = " ";
 };
 
 // Getters
@@ -95,21 +94,21 @@ int Node::getId() const
     return this->id;
 }
 
-int Node::getVisited()
-{
-    return this->visited;
-}
-
 Node *Node::getNextNode()
 {
     return this->nextNode;
 }
 
-string Node::getTag()
+NodeTag Node::getTag()
 {
     return this->tag;
 }
 
+bool Node::isFinal()
+{
+    return this->tag == FINAL_NODE;
+}
+
 double Node::getHeuristic()
 {
     return this->heuristic;
@@ -121,35 +120,25 @@ void Node::setNextNode(Node *nextNode)
     this->nextNode = nextNode;
 }
 
-// Other Methods
-void Node::setVisited()
+void Node::setEdges(Edge *firstEdge, Edge *lastEdge)
+{
+    this->firstEdge = firstEdge;
+    this->lastEdge = lastEdge;
+}
+
+void Node::setHeuristic(double heuristic)
 {
-    this->visited = true;
+    this->heuristic = heuristic;
 }
 
-void Node::insertEdge(int sourceId, int targetId, int direction, double weight)
-{
-    // Verifies whether there are at least one edge in the node
-    if (this->firstEdge != nullptr)
-    {
-        // Allocating the new edge and keeping the integrity of the edge list
-        Edge *edge = new Edge(sourceId, targetId, weight);
-        edge->setDirection(direction);
-        this->lastEdge->setNextEdge(edge);
-        this->lastEdge = edge;
-    }
-    else
-    {
-        // Allocating the new edge and keeping the integrity of the edge list
-        this->firstEdge = new Edge(sourceId, targetId, weight);
-        this->firstEdge->setDirection(direction);
-        this->lastEdge = this->firstEdge;
-    }
+int Node::getX()
+{
+    return this->x;
 }
 
-string Node::getPosition()
+int Node::getY()
 {
-    return this->position;
+    return this->y;
 }
 
 #endif // NODE_H
@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ * Implementation of the TAD QueryMaze
+ **************************************************************************************************/
+
+#ifndef QUERYMAZE_H
+#define QUERYMAZE_H
+
+#include "Edge.h"
+#include "Heuristic.h"
+
+using namespace std;
+
+// Visão de um labirinto com início e objetivo próprios, para consultas entre pares de nós
+// quaisquer. Só guarda os ids e a posição do objetivo; o labirinto é compartilhado e apenas
+// lido, então cada consulta pode ter a sua visão sem copiar nada.
+//
+// A heurística é a política Heuristic (euclidiana por padrão, ver Heuristic.h) aplicada à
+// diferença entre getX/getY do nó e do objetivo da consulta, no labirinto (Graph, GridMaze
+// ou MappedGraph).
+template <class Maze, class Heuristic = EuclideanHeuristic>
+class QueryMaze
+{
+
+private:
+    Maze *maze;
+    int startId;
+    int goalId;
+    int goalX;
+    int goalY;
+
+public:
+    typedef Heuristic HeuristicPolicy;
+
+    QueryMaze(Maze *maze, int startId, int goalId);
+    ~QueryMaze();
+
+    // Interface usada pelas buscas da árvore
+    int getNodeCount();
+    int getStartId();
+    int getGoalId();
+    int getX(int id);
+    int getY(int id);
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    bool isUniformGrid();
+    unsigned long long getVersion();
+};
+
+// Construtor
+template <class Maze, class Heuristic>
+QueryMaze<Maze, Heuristic>::QueryMaze(Maze *maze, int startId, int goalId)
+{
+    this->maze = maze;
+    this->startId = startId;
+    this->goalId = goalId;
+    this->goalX = maze->getX(goalId);
+    this->goalY = maze->getY(goalId);
+}
+
+// Destrutor
+template <class Maze, class Heuristic>
+QueryMaze<Maze, Heuristic>::~QueryMaze()
+{
+    this->maze = nullptr;
+}
+
+// Interface de busca
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getNodeCount()
+{
+    return this->maze->getNodeCount();
+}
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getStartId()
+{
+    return this->startId;
+}
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getGoalId()
+{
+    return this->goalId;
+}
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getX(int id)
+{
+    return this->maze->getX(id);
+}
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getY(int id)
+{
+    return this->maze->getY(id);
+}
+
+template <class Maze, class Heuristic>
+bool QueryMaze<Maze, Heuristic>::isFinal(int id)
+{
+    return id == this->goalId;
+}
+
+template <class Maze, class Heuristic>
+double QueryMaze<Maze, Heuristic>::getHeuristic(int id)
+{
+    return Heuristic::estimate(this->goalX - this->maze->getX(id), this->goalY - this->maze->getY(id));
+}
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getEdges(int id, Edge edges[4])
+{
+    return this->maze->getEdges(id, edges);
+}
+
+template <class Maze, class Heuristic>
+int QueryMaze<Maze, Heuristic>::getMaxIntegerWeight()
+{
+    return this->maze->getMaxIntegerWeight();
+}
+
+template <class Maze, class Heuristic>
+bool QueryMaze<Maze, Heuristic>::isUniformGrid()
+{
+    return this->maze->isUniformGrid();
+}
+
+// Versão do labirinto por baixo: a visão não muda, só o labirinto
+template <class Maze, class Heuristic>
+unsigned long long QueryMaze<Maze, Heuristic>::getVersion()
+{
+    return this->maze->getVersion();
+}
+
+#endif // QUERYMAZE_H
@@ -0,0 +1,187 @@
+/**************************************************************************************************
+ * Implementation of the TAD BucketQueue
+ **************************************************************************************************/
+
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// Fila de baldes monótona (algoritmo de Dial) para labirintos com pesos inteiros pequenos.
+// A prioridade é truncada para inteiro e cada inteiro tem o seu balde, em um vetor circular
+// que dobra quando aparece uma prioridade além do alcance atual. Inserir e remover são O(1);
+// a remoção só avança o cursor até o próximo balde não vazio.
+//
+// Com pesos inteiros o custo g é exato; no A* o balde é o piso de g + h, o que mantém a
+// ordem necessária para a heurística consistente (um caminho pior custa pelo menos 1 a mais).
+//
+// Tem a mesma interface do IndexedHeap. Diminuir a prioridade insere uma nova entrada e
+// invalida a antiga, que é descartada quando o seu balde é esvaziado.
+class BucketQueue
+{
+
+private:
+    struct Entry
+    {
+        int id;
+        int value;
+    };
+
+    vector<vector<Entry>> buckets;
+    vector<int> values;    // Valor atual de cada id na fila, -1 se não está na fila
+    long long currentKey;  // Prioridade do balde do cursor
+    int size;              // Ids na fila (sem contar entradas invalidadas)
+
+    vector<Entry> &getBucket(long long key);
+    void grow(long long key);
+    void insert(int id, double priority, int value);
+
+public:
+    static const int MAX_WEIGHT = 4096; // Maior peso para o qual a fila de baldes é usada
+
+    BucketQueue();
+    ~BucketQueue();
+
+    void reset(int nodeCount);
+
+    // Getters
+    bool isEmpty();
+    int getSize();
+    bool contains(int id);
+
+    // Operations
+    void push(int id, double priority, int value);
+    void decrease(int id, double priority, int value);
+    void pop(int &id, int &value);
+};
+
+// Construtor
+BucketQueue::BucketQueue()
+{
+    this->buckets.resize(64);
+    this->currentKey = 0;
+    this->size = 0;
+}
+
+// Destrutor
+BucketQueue::~BucketQueue()
+{
+    this->buckets.clear();
+    this->values.clear();
+    this->size = 0;
+}
+
+// Esvazia a fila para uma busca em um labirinto com nodeCount nós
+void BucketQueue::reset(int nodeCount)
+{
+    if ((int)this->values.size() != nodeCount)
+        this->values.assign(nodeCount, -1);
+
+    for (vector<Entry> &bucket : this->buckets)
+    {
+        for (Entry &entry : bucket)
+            this->values[entry.id] = -1;
+        bucket.clear();
+    }
+
+    this->currentKey = 0;
+    this->size = 0;
+}
+
+// O número de baldes é potência de 2, então o índice circular é só uma máscara
+vector<BucketQueue::Entry> &BucketQueue::getBucket(long long key)
+{
+    return this->buckets[key & (long long)(this->buckets.size() - 1)];
+}
+
+// Dobra o número de baldes até caber a prioridade, redistribuindo as entradas
+void BucketQueue::grow(long long key)
+{
+    size_t count = this->buckets.size();
+    while (key - this->currentKey >= (long long)count)
+        count *= 2;
+
+    vector<vector<Entry>> old(count);
+    old.swap(this->buckets);
+
+    // Os baldes antigos cobrem [currentKey, currentKey + tamanho antigo)
+    for (size_t offset = 0; offset < old.size(); offset++)
+    {
+        long long bucketKey = this->currentKey + (long long)offset;
+        vector<Entry> &bucket = old[bucketKey & (long long)(old.size() - 1)];
+        if (!bucket.empty())
+            this->getBucket(bucketKey).swap(bucket);
+    }
+}
+
+void BucketQueue::insert(int id, double priority, int value)
+{
+    long long key = (long long)floor(priority);
+
+    // Prioridade abaixo do cursor (heurística inconsistente): entra no balde atual
+    if (key < this->currentKey)
+        key = this->currentKey;
+    if (key - this->currentKey >= (long long)this->buckets.size())
+        this->grow(key);
+
+    this->getBucket(key).push_back({id, value});
+    this->values[id] = value;
+}
+
+// Getters
+bool BucketQueue::isEmpty()
+{
+    return this->size == 0;
+}
+
+int BucketQueue::getSize()
+{
+    return this->size;
+}
+
+bool BucketQueue::contains(int id)
+{
+    return this->values[id] >= 0;
+}
+
+// Operations
+void BucketQueue::push(int id, double priority, int value)
+{
+    this->insert(id, priority, value);
+    this->size++;
+}
+
+void BucketQueue::decrease(int id, double priority, int value)
+{
+    this->insert(id, priority, value);
+}
+
+// Remove um nó do balde de menor prioridade (o último inserido nele)
+void BucketQueue::pop(int &id, int &value)
+{
+    while (true)
+    {
+        vector<Entry> &bucket = this->getBucket(this->currentKey);
+        while (!bucket.empty())
+        {
+            Entry entry = bucket.back();
+            bucket.pop_back();
+
+            // Entrada invalidada por uma diminuição de prioridade
+            if (this->values[entry.id] != entry.value)
+                continue;
+
+            id = entry.id;
+            value = entry.value;
+            this->values[id] = -1;
+            this->size--;
+            return;
+        }
+        this->currentKey++;
+    }
+}
+
+#endif // BUCKETQUEUE_H
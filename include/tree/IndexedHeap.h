@@ -0,0 +1,184 @@
+/**************************************************************************************************
+ * Implementation of the TAD IndexedHeap
+ **************************************************************************************************/
+
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <vector>
+
+using namespace std;
+
+// Heap 4-ário de mínimo indexado pelo id do nó do labirinto. Cada nó aparece no máximo uma
+// vez: o mapa de posições permite diminuir a prioridade de um nó que já está no heap, em vez
+// de inserir uma cópia, então o heap nunca passa do número de nós.
+//
+// Cada entrada carrega um valor (o estado da árvore que alcançou o nó com essa prioridade).
+class IndexedHeap
+{
+
+private:
+    struct Entry
+    {
+        double priority;
+        int id;
+        int value;
+    };
+
+    vector<Entry> entries;
+    vector<int> positions; // Posição de cada id no heap, -1 se não está no heap
+
+    void siftUp(int position);
+    void siftDown(int position);
+    void place(int position, const Entry &entry);
+
+public:
+    IndexedHeap();
+    ~IndexedHeap();
+
+    void reset(int nodeCount);
+
+    // Getters
+    bool isEmpty();
+    int getSize();
+    bool contains(int id);
+    double getPriority(int id);
+    double getMinPriority();
+
+    // Operations
+    void push(int id, double priority, int value);
+    void decrease(int id, double priority, int value);
+    void pop(int &id, int &value);
+};
+
+// Construtor
+IndexedHeap::IndexedHeap()
+{
+}
+
+// Destrutor
+IndexedHeap::~IndexedHeap()
+{
+    this->entries.clear();
+    this->positions.clear();
+}
+
+// Esvazia o heap para uma busca em um labirinto com nodeCount nós; só as entradas que
+// sobraram da busca anterior precisam ser desmarcadas
+void IndexedHeap::reset(int nodeCount)
+{
+    if ((int)this->positions.size() != nodeCount)
+        this->positions.assign(nodeCount, -1);
+    else
+        for (Entry &entry : this->entries)
+            this->positions[entry.id] = -1;
+
+    this->entries.clear();
+}
+
+void IndexedHeap::place(int position, const Entry &entry)
+{
+    this->entries[position] = entry;
+    this->positions[entry.id] = position;
+}
+
+void IndexedHeap::siftUp(int position)
+{
+    Entry entry = this->entries[position];
+    while (position > 0)
+    {
+        int parent = (position - 1) / 4;
+        if (this->entries[parent].priority <= entry.priority)
+            break;
+        this->place(position, this->entries[parent]);
+        position = parent;
+    }
+    this->place(position, entry);
+}
+
+void IndexedHeap::siftDown(int position)
+{
+    int size = (int)this->entries.size();
+    Entry entry = this->entries[position];
+    while (true)
+    {
+        int first = position * 4 + 1;
+        if (first >= size)
+            break;
+
+        // Menor dos até 4 filhos
+        int smallest = first;
+        int last = first + 4 < size ? first + 4 : size;
+        for (int child = first + 1; child < last; child++)
+            if (this->entries[child].priority < this->entries[smallest].priority)
+                smallest = child;
+
+        if (entry.priority <= this->entries[smallest].priority)
+            break;
+        this->place(position, this->entries[smallest]);
+        position = smallest;
+    }
+    this->place(position, entry);
+}
+
+// Getters
+bool IndexedHeap::isEmpty()
+{
+    return this->entries.empty();
+}
+
+int IndexedHeap::getSize()
+{
+    return (int)this->entries.size();
+}
+
+bool IndexedHeap::contains(int id)
+{
+    return this->positions[id] >= 0;
+}
+
+double IndexedHeap::getPriority(int id)
+{
+    return this->entries[this->positions[id]].priority;
+}
+
+// Menor prioridade do heap (o heap não pode estar vazio)
+double IndexedHeap::getMinPriority()
+{
+    return this->entries[0].priority;
+}
+
+// Operations
+void IndexedHeap::push(int id, double priority, int value)
+{
+    this->entries.push_back({priority, id, value});
+    this->positions[id] = (int)this->entries.size() - 1;
+    this->siftUp((int)this->entries.size() - 1);
+}
+
+// Diminui a prioridade de um nó que já está no heap e troca o seu valor
+void IndexedHeap::decrease(int id, double priority, int value)
+{
+    int position = this->positions[id];
+    this->entries[position].priority = priority;
+    this->entries[position].value = value;
+    this->siftUp(position);
+}
+
+// Remove o nó de menor prioridade
+void IndexedHeap::pop(int &id, int &value)
+{
+    id = this->entries[0].id;
+    value = this->entries[0].value;
+    this->positions[id] = -1;
+
+    Entry last = this->entries.back();
+    this->entries.pop_back();
+    if (!this->entries.empty())
+    {
+        this->entries[0] = last;
+        this->siftDown(0);
+    }
+}
+
+#endif // INDEXEDHEAP_H
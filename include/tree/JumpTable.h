@@ -0,0 +1,124 @@
+/**************************************************************************************************
+ * Implementation of the TAD JumpTable
+ **************************************************************************************************/
+
+#ifndef JUMPTABLE_H
+#define JUMPTABLE_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Pontos de salto do Jump Point Search que não dependem do objetivo: para cada nó e direção,
+// o primeiro nó da linha com vizinho forçado (ou, na horizontal, de onde um salto vertical acha
+// um) e a distância até ele; sem ponto de salto, -1 e o número de passos até o fim da linha.
+// As entradas são calculadas na primeira consulta, e cada linha é varrida uma vez por direção.
+//
+// A tabela serve a um labirinto só (ou a consultas nele com objetivos diferentes) e vale
+// enquanto a versão e o número de nós não mudam; update() confere isso. Como no SearchContext,
+// invalidar só troca a geração, sem limpar o vetor.
+class JumpTable
+{
+
+private:
+    struct Entry
+    {
+        uint32_t mark; // Geração em que a entrada foi calculada
+        int target;
+        int distance;
+    };
+
+    vector<Entry> entries; // 4 por nó, na posição id * 4 + direção
+    vector<int> lines[2];  // Nós da linha sendo varrida: vertical e horizontal (que chama a vertical)
+    int nodeCount;
+    unsigned long long version;
+    uint32_t generation;
+
+public:
+    JumpTable();
+    ~JumpTable();
+
+    void reset(int nodeCount);
+    template <class Maze>
+    void update(Maze *maze);
+
+    // Getters
+    bool find(int id, int direction, int &target, int &distance);
+    vector<int> &getLine(bool horizontal);
+
+    // Setters
+    void insert(int id, int direction, int target, int distance);
+};
+
+// Construtor
+JumpTable::JumpTable()
+{
+    this->nodeCount = 0;
+    this->version = 0;
+    this->generation = 0;
+}
+
+// Destrutor
+JumpTable::~JumpTable()
+{
+    this->generation = 0;
+}
+
+// Descarta todas as entradas e prepara a tabela para um labirinto com nodeCount nós
+void JumpTable::reset(int nodeCount)
+{
+    if (this->nodeCount != nodeCount)
+    {
+        this->nodeCount = nodeCount;
+        this->entries.assign((size_t)nodeCount * 4, Entry{0, -1, 0});
+        this->generation = 0;
+    }
+
+    // Geração 0 é reservada para "nunca calculado"; ao dar a volta o vetor é limpo
+    this->generation++;
+    if (this->generation == 0)
+    {
+        this->entries.assign((size_t)nodeCount * 4, Entry{0, -1, 0});
+        this->generation = 1;
+    }
+}
+
+// Descarta as entradas se o labirinto mudou desde que foram calculadas
+template <class Maze>
+void JumpTable::update(Maze *maze)
+{
+    if (this->generation != 0 && this->nodeCount == maze->getNodeCount() && this->version == maze->getVersion())
+        return;
+
+    this->reset(maze->getNodeCount());
+    this->version = maze->getVersion();
+}
+
+// Getters
+bool JumpTable::find(int id, int direction, int &target, int &distance)
+{
+    Entry &entry = this->entries[(size_t)id * 4 + direction];
+    if (entry.mark != this->generation)
+        return false;
+
+    target = entry.target;
+    distance = entry.distance;
+    return true;
+}
+
+vector<int> &JumpTable::getLine(bool horizontal)
+{
+    return this->lines[horizontal ? 1 : 0];
+}
+
+// Setters
+void JumpTable::insert(int id, int direction, int target, int distance)
+{
+    Entry &entry = this->entries[(size_t)id * 4 + direction];
+    entry.mark = this->generation;
+    entry.target = target;
+    entry.distance = distance;
+}
+
+#endif // JUMPTABLE_H
@@ -0,0 +1,430 @@
+/**************************************************************************************************
+ * Implementation of the TAD LifelongPlanner
+ **************************************************************************************************/
+
+#ifndef LIFELONGPLANNER_H
+#define LIFELONGPLANNER_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <stack>
+#include <vector>
+
+#include "../maze/Edge.h"
+#include "../perf/perf.h"
+
+using namespace std;
+
+// Replanejamento incremental com o LPA* (Lifelong Planning A*) para labirintos que mudam
+// enquanto são usados, como portas que abrem e fecham. O planejador copia as arestas do
+// labirinto para listas que podem mudar (insertEdge, removeEdge, setEdgeWeight) e guarda, para
+// cada nó, o custo g e o rhs, a melhor estimativa a partir dos vizinhos. Depois de uma
+// mudança, só os nós cujo g deixou de bater com o rhs voltam para a fila, então findPath
+// refaz apenas a parte afetada da busca anterior.
+//
+// Início e objetivo são os do labirinto, e a heurística é a dele, copiada na montagem; ela
+// precisa continuar consistente com os pesos depois das mudanças. As arestas são não
+// direcionadas, como no Graph.
+//
+// O planejador também tem a interface de busca da árvore, com as arestas atuais, então uma
+// busca do zero (Tree::aStarSearch) roda sobre o mesmo labirinto para comparar.
+class LifelongPlanner
+{
+
+private:
+    struct Arc
+    {
+        int target;
+        double weight;
+        int direction;
+    };
+
+    // Entrada da fila de prioridade; as que ficaram velhas são descartadas ao sair
+    struct QueueEntry
+    {
+        double key1;
+        double key2;
+        int id;
+
+        bool operator>(const QueueEntry &other) const
+        {
+            return key1 > other.key1 || (key1 == other.key1 && key2 > other.key2);
+        }
+    };
+
+    vector<vector<Arc>> arcs;
+    vector<double> heuristics;
+    vector<double> g;
+    vector<double> rhs;
+    priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>> openList;
+    int startId;
+    int goalId;
+    int maxIntegerWeight;
+    unsigned long long version;
+    bool initialized;
+    int expandedCount;
+    long long totalExpandedCount;
+    double elapsedTime;
+
+    QueueEntry calculateKey(int id);
+    bool isCurrent(const QueueEntry &entry);
+    void updateNode(int id);
+    void computeShortestPath();
+    Arc *findArc(int sourceId, int targetId);
+    void setArc(int sourceId, int targetId, int direction, double weight);
+
+public:
+    LifelongPlanner();
+    ~LifelongPlanner();
+
+    // Operations
+    template <class Maze>
+    void build(Maze *maze);
+    stack<int> findPath();
+    void insertEdge(int sourceId, int targetId, int direction, double weight);
+    void removeEdge(int sourceId, int targetId);
+    void setEdgeWeight(int sourceId, int targetId, double weight);
+
+    // Getters
+    double getCost();
+    int getExpandedCount();
+    long long getTotalExpandedCount();
+    double getElapsedTime();
+
+    // Interface usada pelas buscas da árvore
+    int getNodeCount();
+    int getStartId();
+    int getGoalId();
+    bool isFinal(int id);
+    double getHeuristic(int id);
+    int getEdges(int id, Edge edges[4]);
+    int getMaxIntegerWeight();
+    unsigned long long getVersion();
+};
+
+// Construtor
+LifelongPlanner::LifelongPlanner()
+{
+    this->startId = -1;
+    this->goalId = -1;
+    this->maxIntegerWeight = 0;
+    this->version = 0;
+    this->initialized = false;
+    this->expandedCount = 0;
+    this->totalExpandedCount = 0;
+    this->elapsedTime = 0;
+}
+
+// Destrutor
+LifelongPlanner::~LifelongPlanner()
+{
+    this->startId = -1;
+    this->goalId = -1;
+}
+
+template <class Maze>
+void LifelongPlanner::build(Maze *maze)
+{
+    int nodeCount = maze->getNodeCount();
+    this->arcs.assign(nodeCount, vector<Arc>());
+    this->heuristics.assign(nodeCount, 0);
+    this->startId = maze->getStartId();
+    this->goalId = maze->getGoalId();
+    this->maxIntegerWeight = maze->getMaxIntegerWeight();
+    this->version++;
+
+    Edge edges[4];
+    for (int id = 0; id < nodeCount; id++)
+    {
+        this->heuristics[id] = maze->getHeuristic(id);
+        int numEdges = maze->getEdges(id, edges);
+        for (int i = 0; i < numEdges; i++)
+            this->arcs[id].push_back({edges[i].getTargetId(), edges[i].getWeight(), edges[i].getDirection()});
+    }
+
+    this->initialized = false;
+    this->totalExpandedCount = 0;
+}
+
+// Chave [min(g, rhs) + h, min(g, rhs)], comparada em ordem lexicográfica
+LifelongPlanner::QueueEntry LifelongPlanner::calculateKey(int id)
+{
+    double best = min(this->g[id], this->rhs[id]);
+    return {best + this->heuristics[id], best, id};
+}
+
+// A entrada ainda vale se o nó continua inconsistente e com a mesma chave
+bool LifelongPlanner::isCurrent(const QueueEntry &entry)
+{
+    if (this->g[entry.id] == this->rhs[entry.id])
+        return false;
+    QueueEntry key = this->calculateKey(entry.id);
+    return key.key1 == entry.key1 && key.key2 == entry.key2;
+}
+
+// Recalcula o rhs do nó a partir dos vizinhos e o põe na fila se ficou inconsistente
+void LifelongPlanner::updateNode(int id)
+{
+    if (id != this->startId)
+    {
+        double best = numeric_limits<double>::infinity();
+        for (Arc &arc : this->arcs[id])
+            best = min(best, this->g[arc.target] + arc.weight);
+        this->rhs[id] = best;
+    }
+
+    if (this->g[id] != this->rhs[id])
+        this->openList.push(this->calculateKey(id));
+}
+
+void LifelongPlanner::computeShortestPath()
+{
+    this->expandedCount = 0;
+
+    while (true)
+    {
+        while (!this->openList.empty() && !this->isCurrent(this->openList.top()))
+            this->openList.pop();
+
+        QueueEntry goalKey = this->calculateKey(this->goalId);
+        if (this->openList.empty() ||
+            (!(goalKey > this->openList.top()) && this->g[this->goalId] == this->rhs[this->goalId]))
+            break;
+
+        int id = this->openList.top().id;
+        this->openList.pop();
+        this->expandedCount++;
+
+        if (this->g[id] > this->rhs[id])
+            this->g[id] = this->rhs[id];
+        else
+        {
+            this->g[id] = numeric_limits<double>::infinity();
+            this->updateNode(id);
+        }
+
+        for (Arc &arc : this->arcs[id])
+            this->updateNode(arc.target);
+    }
+
+    this->totalExpandedCount += this->expandedCount;
+}
+
+// Menor caminho do início ao objetivo com as arestas atuais, com o início no topo. A primeira
+// chamada é um A* completo; as seguintes só reparam o que as mudanças afetaram
+stack<int> LifelongPlanner::findPath()
+{
+    stack<int> pilha;
+    if (this->startId < 0 || this->goalId < 0)
+        return pilha;
+
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    if (!this->initialized)
+    {
+        int nodeCount = this->getNodeCount();
+        this->g.assign(nodeCount, numeric_limits<double>::infinity());
+        this->rhs.assign(nodeCount, numeric_limits<double>::infinity());
+        this->openList = priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>>();
+        this->rhs[this->startId] = 0;
+        this->openList.push(this->calculateKey(this->startId));
+        this->initialized = true;
+    }
+
+    this->computeShortestPath();
+
+    // Do objetivo para o início, sempre pelo vizinho que dá o g do nó. Com arestas de peso zero
+    // o g pode formar um ciclo, então a volta para (e o caminho sai vazio) se um nó não tem
+    // vizinho ou se o caminho já tem todos os nós do labirinto
+    if (this->g[this->goalId] != numeric_limits<double>::infinity())
+    {
+        pilha.push(this->goalId);
+        for (int id = this->goalId; id != this->startId;)
+        {
+            if ((int)pilha.size() >= this->getNodeCount())
+            {
+                pilha = stack<int>();
+                break;
+            }
+
+            int bestId = -1;
+            double best = numeric_limits<double>::infinity();
+            for (Arc &arc : this->arcs[id])
+            {
+                if (this->g[arc.target] + arc.weight < best)
+                {
+                    best = this->g[arc.target] + arc.weight;
+                    bestId = arc.target;
+                }
+            }
+            if (bestId < 0)
+            {
+                pilha = stack<int>();
+                break;
+            }
+            id = bestId;
+            pilha.push(id);
+        }
+    }
+
+    clock.stop();
+    this->elapsedTime = clock.elapsed_time();
+    return pilha;
+}
+
+LifelongPlanner::Arc *LifelongPlanner::findArc(int sourceId, int targetId)
+{
+    for (Arc &arc : this->arcs[sourceId])
+        if (arc.target == targetId)
+            return &arc;
+    return nullptr;
+}
+
+// Cria, muda o peso ou (peso infinito) remove a aresta sourceId -> targetId; não cria uma 5ª
+// aresta no nó
+void LifelongPlanner::setArc(int sourceId, int targetId, int direction, double weight)
+{
+    vector<Arc> &nodeArcs = this->arcs[sourceId];
+    Arc *arc = this->findArc(sourceId, targetId);
+    this->version++;
+    if (weight == numeric_limits<double>::infinity())
+    {
+        if (arc != nullptr)
+            nodeArcs.erase(nodeArcs.begin() + (arc - nodeArcs.data()));
+        return;
+    }
+
+    if (arc != nullptr)
+        arc->weight = weight;
+    else if (nodeArcs.size() < 4)
+        nodeArcs.push_back({targetId, weight, direction});
+    else
+        return;
+
+    // Um limite acima do maior peso basta para a fila de baldes
+    if (this->maxIntegerWeight >= 0)
+        this->maxIntegerWeight = weight < 0 || weight != floor(weight) || weight > INT_MAX
+                                     ? -1
+                                     : max(this->maxIntegerWeight, (int)weight);
+}
+
+// Insere a aresta nos dois sentidos; a aresta de volta recebe a direção oposta (como no Graph).
+// Um nó tem no máximo 4 arestas: se uma das pontas já está cheia, nada é inserido
+void LifelongPlanner::insertEdge(int sourceId, int targetId, int direction, double weight)
+{
+    if ((this->findArc(sourceId, targetId) == nullptr && this->arcs[sourceId].size() >= 4) ||
+        (this->findArc(targetId, sourceId) == nullptr && this->arcs[targetId].size() >= 4))
+        return;
+
+    this->setArc(sourceId, targetId, direction, weight);
+    this->setArc(targetId, sourceId, direction >= 0 ? (direction + 2) % 4 : direction, weight);
+
+    if (this->initialized)
+    {
+        this->updateNode(sourceId);
+        this->updateNode(targetId);
+    }
+}
+
+void LifelongPlanner::removeEdge(int sourceId, int targetId)
+{
+    this->setEdgeWeight(sourceId, targetId, numeric_limits<double>::infinity());
+}
+
+// Muda o peso de uma aresta que já existe (infinito a remove)
+void LifelongPlanner::setEdgeWeight(int sourceId, int targetId, double weight)
+{
+    Arc *arc = this->findArc(sourceId, targetId);
+    if (arc == nullptr)
+        return;
+
+    this->setArc(sourceId, targetId, arc->direction, weight);
+    this->setArc(targetId, sourceId, -1, weight);
+
+    if (this->initialized)
+    {
+        this->updateNode(sourceId);
+        this->updateNode(targetId);
+    }
+}
+
+// Getters
+
+// Custo do caminho da última chamada de findPath, infinito se não houver caminho
+double LifelongPlanner::getCost()
+{
+    return this->initialized ? this->g[this->goalId] : numeric_limits<double>::infinity();
+}
+
+// Nós expandidos pela última chamada de findPath
+int LifelongPlanner::getExpandedCount()
+{
+    return this->expandedCount;
+}
+
+long long LifelongPlanner::getTotalExpandedCount()
+{
+    return this->totalExpandedCount;
+}
+
+double LifelongPlanner::getElapsedTime()
+{
+    return this->elapsedTime;
+}
+
+// Interface de busca
+
+int LifelongPlanner::getNodeCount()
+{
+    return (int)this->arcs.size();
+}
+
+int LifelongPlanner::getStartId()
+{
+    return this->startId;
+}
+
+int LifelongPlanner::getGoalId()
+{
+    return this->goalId;
+}
+
+bool LifelongPlanner::isFinal(int id)
+{
+    return id == this->goalId;
+}
+
+double LifelongPlanner::getHeuristic(int id)
+{
+    return this->heuristics[id];
+}
+
+int LifelongPlanner::getEdges(int id, Edge edges[4])
+{
+    int count = (int)this->arcs[id].size();
+    for (int i = 0; i < count; i++)
+    {
+        Arc &arc = this->arcs[id][i];
+        edges[i] = Edge(id, arc.target, 0);
+        edges[i].setDirection(arc.direction);
+        edges[i].setWeight(arc.weight);
+    }
+    return count;
+}
+
+int LifelongPlanner::getMaxIntegerWeight()
+{
+    return this->maxIntegerWeight;
+}
+
+// Muda a cada montagem e a cada aresta inserida, removida ou com peso novo
+unsigned long long LifelongPlanner::getVersion()
+{
+    return this->version;
+}
+
+#endif // LIFELONGPLANNER_H
@@ -0,0 +1,318 @@
+/**************************************************************************************************
+ * Implementation of the TAD PathCache
+ **************************************************************************************************/
+
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <stack>
+#include <unordered_map>
+#include <vector>
+
+#include "../maze/Edge.h"
+
+using namespace std;
+
+// Resultados de buscas já feitas, para consultas que se repetem. A chave é o início, o
+// objetivo, a busca e a versão do labirinto (getVersion), então qualquer mudança no labirinto
+// invalida tudo o que foi guardado antes dela; as entradas velhas nunca mais são achadas e
+// saem pela ordem de uso.
+//
+// O caminho é guardado como o nó inicial e a direção de cada passo, em 2 bits, e é refeito
+// andando pelas arestas do labirinto. Quando uma direção não identifica a aresta (fora de 0 a
+// 3 ou repetida no nó), o caminho fica como a lista de ids. Caminho vazio (sem solução) também
+// é guardado.
+//
+// O limite é de memória, em bytes, contando as entradas e o índice; quando passa dele, sai a
+// entrada usada há mais tempo. Um cache serve a um labirinto só (ou a visões dele com a mesma
+// heurística) e não é seguro entre threads.
+class PathCache
+{
+
+private:
+    struct Key
+    {
+        int startId;
+        int goalId;
+        int algorithm;
+        unsigned long long version;
+
+        bool operator==(const Key &other) const
+        {
+            return startId == other.startId && goalId == other.goalId &&
+                   algorithm == other.algorithm && version == other.version;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            size_t hash = (size_t)key.version * 0x9E3779B97F4A7C15ULL;
+            hash ^= (size_t)(unsigned)key.startId + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+            hash ^= (size_t)(unsigned)key.goalId + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+            hash ^= (size_t)(unsigned)key.algorithm + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        int length;            // Nós do caminho, 0 se não há caminho
+        vector<uint8_t> steps; // Direção de cada passo, 4 por byte
+        vector<int> ids;       // O caminho inteiro, quando as direções não bastam
+    };
+
+    list<Entry> entries; // Da usada mais recentemente para a mais antiga
+    unordered_map<Key, list<Entry>::iterator, KeyHash> index;
+    size_t memoryLimit;
+    size_t memoryUsage;
+    long long hitCount;
+    long long missCount;
+    long long evictionCount;
+
+    size_t getEntrySize(Entry &entry);
+    template <class Maze>
+    Key makeKey(Maze *maze, int algorithm);
+    template <class Maze>
+    void encode(Maze *maze, vector<int> &path, Entry &entry);
+    template <class Maze>
+    bool decode(Maze *maze, Entry &entry, stack<int> &path);
+    void erase(list<Entry>::iterator it);
+    void shrink();
+
+public:
+    PathCache(size_t memoryLimit);
+    ~PathCache();
+
+    // Operations
+    template <class Maze>
+    bool find(Maze *maze, int algorithm, stack<int> &path);
+    template <class Maze>
+    void insert(Maze *maze, int algorithm, stack<int> path);
+    void clear();
+
+    // Getters
+    int getEntryCount();
+    long long getHitCount();
+    long long getMissCount();
+    long long getEvictionCount();
+    size_t getMemoryUsage();
+    size_t getMemoryLimit();
+
+    // Setters
+    void setMemoryLimit(size_t memoryLimit);
+};
+
+// Construtor
+PathCache::PathCache(size_t memoryLimit)
+{
+    this->memoryLimit = memoryLimit;
+    this->memoryUsage = 0;
+    this->hitCount = 0;
+    this->missCount = 0;
+    this->evictionCount = 0;
+}
+
+// Destrutor
+PathCache::~PathCache()
+{
+    this->clear();
+}
+
+// Bytes da entrada na lista e no índice, com os vetores do caminho
+size_t PathCache::getEntrySize(Entry &entry)
+{
+    size_t nodes = sizeof(Entry) + 2 * sizeof(void *) +
+                   sizeof(Key) + sizeof(list<Entry>::iterator) + 2 * sizeof(void *);
+    return nodes + entry.steps.capacity() * sizeof(uint8_t) + entry.ids.capacity() * sizeof(int);
+}
+
+template <class Maze>
+PathCache::Key PathCache::makeKey(Maze *maze, int algorithm)
+{
+    return {maze->getStartId(), maze->getGoalId(), algorithm, maze->getVersion()};
+}
+
+template <class Maze>
+void PathCache::encode(Maze *maze, vector<int> &path, Entry &entry)
+{
+    entry.length = (int)path.size();
+    if (path.size() < 2)
+    {
+        entry.ids = path;
+        return;
+    }
+
+    entry.steps.assign((path.size() - 1 + 3) / 4, 0);
+    Edge edges[4];
+    for (size_t i = 0; i + 1 < path.size(); i++)
+    {
+        int numEdges = maze->getEdges(path[i], edges);
+        int direction = -1;
+        int matches = 0;
+        for (int j = 0; j < numEdges; j++)
+            if (edges[j].getTargetId() == path[i + 1])
+                direction = edges[j].getDirection();
+        for (int j = 0; j < numEdges; j++)
+            if (edges[j].getDirection() == direction)
+                matches++;
+
+        if (direction < 0 || direction > 3 || matches != 1)
+        {
+            entry.steps.clear();
+            entry.steps.shrink_to_fit();
+            entry.ids = path;
+            return;
+        }
+        entry.steps[i / 4] |= (uint8_t)(direction << (i % 4 * 2));
+    }
+    entry.ids.assign(1, path[0]);
+}
+
+// Refaz o caminho com o início no topo; falha se uma direção não tem mais aresta
+template <class Maze>
+bool PathCache::decode(Maze *maze, Entry &entry, stack<int> &path)
+{
+    vector<int> ids;
+    if (entry.steps.empty())
+        ids = entry.ids;
+    else
+    {
+        ids.reserve(entry.length);
+        ids.push_back(entry.ids[0]);
+        Edge edges[4];
+        for (int i = 0; i + 1 < entry.length; i++)
+        {
+            int direction = (entry.steps[i / 4] >> (i % 4 * 2)) & 3;
+            int numEdges = maze->getEdges(ids.back(), edges);
+            int nextId = -1;
+            for (int j = 0; j < numEdges && nextId < 0; j++)
+                if (edges[j].getDirection() == direction)
+                    nextId = edges[j].getTargetId();
+            if (nextId < 0)
+                return false;
+            ids.push_back(nextId);
+        }
+    }
+
+    path = stack<int>();
+    for (int i = (int)ids.size() - 1; i >= 0; i--)
+        path.push(ids[i]);
+    return true;
+}
+
+void PathCache::erase(list<Entry>::iterator it)
+{
+    this->memoryUsage -= this->getEntrySize(*it);
+    this->index.erase(it->key);
+    this->entries.erase(it);
+}
+
+// Descarta as entradas mais antigas até caber no limite
+void PathCache::shrink()
+{
+    while (this->memoryUsage > this->memoryLimit && !this->entries.empty())
+    {
+        this->erase(prev(this->entries.end()));
+        this->evictionCount++;
+    }
+}
+
+// Caminho guardado para a consulta do labirinto (início, objetivo e versão atuais) com essa
+// busca; devolve false se não há
+template <class Maze>
+bool PathCache::find(Maze *maze, int algorithm, stack<int> &path)
+{
+    auto found = this->index.find(this->makeKey(maze, algorithm));
+    if (found == this->index.end() || !this->decode(maze, *found->second, path))
+    {
+        this->missCount++;
+        return false;
+    }
+
+    this->entries.splice(this->entries.begin(), this->entries, found->second);
+    this->hitCount++;
+    return true;
+}
+
+// Guarda o resultado da busca (início no topo, como as buscas devolvem)
+template <class Maze>
+void PathCache::insert(Maze *maze, int algorithm, stack<int> path)
+{
+    Key key = this->makeKey(maze, algorithm);
+    auto found = this->index.find(key);
+    if (found != this->index.end())
+        this->erase(found->second);
+
+    vector<int> ids;
+    ids.reserve(path.size());
+    while (!path.empty())
+    {
+        ids.push_back(path.top());
+        path.pop();
+    }
+
+    Entry entry;
+    entry.key = key;
+    this->encode(maze, ids, entry);
+
+    size_t size = this->getEntrySize(entry);
+    if (size > this->memoryLimit)
+        return;
+
+    this->entries.push_front(move(entry));
+    this->index[key] = this->entries.begin();
+    this->memoryUsage += size;
+    this->shrink();
+}
+
+void PathCache::clear()
+{
+    this->entries.clear();
+    this->index.clear();
+    this->memoryUsage = 0;
+}
+
+// Getters
+int PathCache::getEntryCount()
+{
+    return (int)this->entries.size();
+}
+
+long long PathCache::getHitCount()
+{
+    return this->hitCount;
+}
+
+long long PathCache::getMissCount()
+{
+    return this->missCount;
+}
+
+long long PathCache::getEvictionCount()
+{
+    return this->evictionCount;
+}
+
+size_t PathCache::getMemoryUsage()
+{
+    return this->memoryUsage;
+}
+
+size_t PathCache::getMemoryLimit()
+{
+    return this->memoryLimit;
+}
+
+// Setters
+void PathCache::setMemoryLimit(size_t memoryLimit)
+{
+    this->memoryLimit = memoryLimit;
+    this->shrink();
+}
+
+#endif // PATHCACHE_H
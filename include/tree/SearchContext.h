@@ -0,0 +1,175 @@
+/**************************************************************************************************
+ * Implementation of the TAD SearchContext
+ **************************************************************************************************/
+
+#ifndef SEARCHCONTEXT_H
+#define SEARCHCONTEXT_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// Estado de uma busca, separado do labirinto: flags de visitado/fechado, custo g e pai de
+// cada nó, em vetores indexados pelo id. O labirinto fica somente leitura durante a busca,
+// então várias buscas podem usar o mesmo labirinto, cada uma com seu contexto.
+//
+// Os flags são marcas da geração atual: reset() só incrementa a geração, sem limpar os
+// vetores, e o custo/pai de um nó só valem se ele foi alcançado nesta geração. Os vetores
+// de fechado, custo e pai só são alocados quando a busca os usa pela primeira vez.
+class SearchContext
+{
+
+private:
+    vector<uint32_t> visitedMark; // Geração em que o nó foi visitado (expandido)
+    vector<uint32_t> closedMark;  // Geração em que o nó foi fechado
+    vector<uint32_t> reachedMark; // Geração em que o nó recebeu custo/pai
+    vector<double> cost;          // Custo g
+    vector<int> parent;           // Nó pai no caminho
+    int nodeCount;
+    uint32_t generation;
+    uint32_t visitedGeneration; // Geração das marcas de visitado, que podem ser limpas sozinhas
+
+    void clearMarks();
+
+public:
+    SearchContext();
+    ~SearchContext();
+
+    void reset(int nodeCount);
+    void clearVisited();
+
+    // Getters
+    int getNodeCount();
+    bool getVisited(int id);
+    bool getClosed(int id);
+    bool isReached(int id);
+    double getCost(int id);
+    int getParent(int id);
+
+    // Setters
+    void setVisited(int id);
+    void setClosed(int id);
+    void setReached(int id, double cost, int parent);
+};
+
+// Construtor
+SearchContext::SearchContext()
+{
+    this->nodeCount = 0;
+    this->generation = 0;
+    this->visitedGeneration = 0;
+}
+
+// Destrutor
+SearchContext::~SearchContext()
+{
+    this->generation = 0;
+}
+
+void SearchContext::clearMarks()
+{
+    this->visitedMark.assign(this->nodeCount, 0);
+    this->closedMark.clear();
+    this->reachedMark.clear();
+    this->cost.clear();
+    this->parent.clear();
+}
+
+// Prepara o contexto para uma nova busca em um labirinto com nodeCount nós
+void SearchContext::reset(int nodeCount)
+{
+    if (this->nodeCount != nodeCount)
+    {
+        this->nodeCount = nodeCount;
+        this->clearMarks();
+        this->generation = 0;
+        this->visitedGeneration = 0;
+    }
+
+    // Geração 0 é reservada para "nunca marcado"; ao dar a volta os vetores são limpos
+    this->generation++;
+    if (this->generation == 0)
+    {
+        this->clearMarks();
+        this->generation = 1;
+        this->visitedGeneration = 0;
+    }
+    this->clearVisited();
+}
+
+// Desmarca todos os visitados, mantendo custos e pais (usado pelo A* anytime entre iterações)
+void SearchContext::clearVisited()
+{
+    this->visitedGeneration++;
+    if (this->visitedGeneration == 0)
+    {
+        this->visitedMark.assign(this->nodeCount, 0);
+        this->visitedGeneration = 1;
+    }
+}
+
+// Getters
+int SearchContext::getNodeCount()
+{
+    return this->nodeCount;
+}
+
+bool SearchContext::getVisited(int id)
+{
+    return this->visitedMark[id] == this->visitedGeneration;
+}
+
+bool SearchContext::getClosed(int id)
+{
+    return !this->closedMark.empty() && this->closedMark[id] == this->generation;
+}
+
+bool SearchContext::isReached(int id)
+{
+    return !this->reachedMark.empty() && this->reachedMark[id] == this->generation;
+}
+
+// Custo g do nó, infinito se ele ainda não foi alcançado nesta busca
+double SearchContext::getCost(int id)
+{
+    if (!this->isReached(id))
+        return numeric_limits<double>::infinity();
+    return this->cost[id];
+}
+
+int SearchContext::getParent(int id)
+{
+    if (!this->isReached(id))
+        return -1;
+    return this->parent[id];
+}
+
+// Setters
+void SearchContext::setVisited(int id)
+{
+    this->visitedMark[id] = this->visitedGeneration;
+}
+
+void SearchContext::setClosed(int id)
+{
+    if (this->closedMark.empty())
+        this->closedMark.assign(this->nodeCount, 0);
+    this->closedMark[id] = this->generation;
+}
+
+void SearchContext::setReached(int id, double cost, int parent)
+{
+    if (this->reachedMark.empty())
+    {
+        this->reachedMark.assign(this->nodeCount, 0);
+        this->cost.assign(this->nodeCount, 0);
+        this->parent.assign(this->nodeCount, -1);
+    }
+    this->reachedMark[id] = this->generation;
+    this->cost[id] = cost;
+    this->parent[id] = parent;
+}
+
+#endif // SEARCHCONTEXT_H
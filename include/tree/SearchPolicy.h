@@ -0,0 +1,127 @@
+/**************************************************************************************************
+ * Implementation of the search policies
+ **************************************************************************************************/
+
+#ifndef SEARCHPOLICY_H
+#define SEARCHPOLICY_H
+
+#include "../maze/Edge.h"
+
+using namespace std;
+
+// Políticas da busca com fronteira (Tree::frontierSearch): o que muda entre as buscas em
+// largura, em profundidade, gulosa, de custo uniforme e A* além do tipo de fronteira.
+//
+//   TRACK_COSTS  guarda o custo de cada nó e só gera um estado quando o caminho até o nó
+//                destino é mais barato que o melhor já achado; sem ele, todo estado gerado
+//                entra na fronteira
+//   getPriority  prioridade do nó na fronteira a partir do custo acumulado até ele
+//   orderRules   ordem em que as regras do estado viram filhos
+//
+// Tudo é resolvido em tempo de compilação, então cada busca é um laço próprio, sem testes
+// de qual busca está rodando.
+
+// Busca em largura e em profundidade: a ordem vem só da fronteira
+struct UnorderedPolicy
+{
+    static const bool TRACK_COSTS = false;
+
+    template <class Maze>
+    static double getPriority(Maze *maze, int id, double cost);
+    template <class Maze>
+    static void orderRules(Maze *maze, Edge rules[4]);
+};
+
+// Busca gulosa: em profundidade, com os filhos empilhados do maior para o menor valor da
+// heurística, então o de menor heurística sai primeiro
+struct HeuristicOrderPolicy
+{
+    static const bool TRACK_COSTS = false;
+
+    template <class Maze>
+    static double getPriority(Maze *maze, int id, double cost);
+    template <class Maze>
+    static void orderRules(Maze *maze, Edge rules[4]);
+};
+
+// Busca de custo uniforme: prioridade é o custo
+struct CostPolicy
+{
+    static const bool TRACK_COSTS = true;
+
+    template <class Maze>
+    static double getPriority(Maze *maze, int id, double cost);
+    template <class Maze>
+    static void orderRules(Maze *maze, Edge rules[4]);
+};
+
+// A*: prioridade é o custo até o nó mais a heurística dele
+struct CostPlusHeuristicPolicy
+{
+    static const bool TRACK_COSTS = true;
+
+    template <class Maze>
+    static double getPriority(Maze *maze, int id, double cost);
+    template <class Maze>
+    static void orderRules(Maze *maze, Edge rules[4]);
+};
+
+template <class Maze>
+double UnorderedPolicy::getPriority(Maze *, int, double)
+{
+    return 0;
+}
+
+template <class Maze>
+void UnorderedPolicy::orderRules(Maze *, Edge[4])
+{
+}
+
+template <class Maze>
+double HeuristicOrderPolicy::getPriority(Maze *, int, double)
+{
+    return 0;
+}
+
+// Bubble sort decrescente pela heurística do nó destino; regras nulas ficam onde estão
+template <class Maze>
+void HeuristicOrderPolicy::orderRules(Maze *maze, Edge rules[4])
+{
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4 - i - 1; j++)
+        {
+            if (rules[j].isValid() && rules[j + 1].isValid() &&
+                maze->getHeuristic(rules[j].getTargetId()) < maze->getHeuristic(rules[j + 1].getTargetId()))
+            {
+                Edge temp = rules[j];
+                rules[j] = rules[j + 1];
+                rules[j + 1] = temp;
+            }
+        }
+    }
+}
+
+template <class Maze>
+double CostPolicy::getPriority(Maze *, int, double cost)
+{
+    return cost;
+}
+
+template <class Maze>
+void CostPolicy::orderRules(Maze *, Edge[4])
+{
+}
+
+template <class Maze>
+double CostPlusHeuristicPolicy::getPriority(Maze *maze, int id, double cost)
+{
+    return cost + maze->getHeuristic(id);
+}
+
+template <class Maze>
+void CostPlusHeuristicPolicy::orderRules(Maze *, Edge[4])
+{
+}
+
+#endif // SEARCHPOLICY_H
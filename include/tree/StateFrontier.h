@@ -0,0 +1,127 @@
+/**************************************************************************************************
+ * Implementation of the TAD StateFrontier
+ **************************************************************************************************/
+
+#ifndef STATEFRONTIER_H
+#define STATEFRONTIER_H
+
+#include <vector>
+
+using namespace std;
+
+// Ordem em que a fronteira devolve os estados
+enum FrontierOrder
+{
+    FIRST_IN_FIRST_OUT, // Fila: busca em largura
+    LAST_IN_FIRST_OUT   // Pilha: busca em profundidade e gulosa
+};
+
+// Fronteira sem prioridade, com a mesma interface do IndexedHeap e da BucketQueue para servir
+// à mesma busca (Tree::frontierSearch). Não é indexada pelo nó do labirinto: cada estado
+// gerado entra, mesmo que o nó já esteja na fronteira, e contains é sempre falso. A prioridade
+// é ignorada.
+//
+// As entradas ficam em um vetor que só é esvaziado no reset; a fila anda com um índice de
+// início, então nenhuma das duas ordens realoca durante a busca depois da primeira.
+template <FrontierOrder Order>
+class StateFrontier
+{
+
+private:
+    struct Entry
+    {
+        int id;
+        int value;
+    };
+
+    vector<Entry> entries;
+    size_t head; // Primeira entrada ainda na fila (só em FIRST_IN_FIRST_OUT)
+
+public:
+    StateFrontier();
+    ~StateFrontier();
+
+    void reset(int nodeCount);
+
+    // Getters
+    bool isEmpty();
+    int getSize();
+    bool contains(int id);
+
+    // Operations
+    void push(int id, double priority, int value);
+    void decrease(int id, double priority, int value);
+    void pop(int &id, int &value);
+};
+
+// Construtor
+template <FrontierOrder Order>
+StateFrontier<Order>::StateFrontier()
+{
+    this->head = 0;
+}
+
+// Destrutor
+template <FrontierOrder Order>
+StateFrontier<Order>::~StateFrontier()
+{
+    this->entries.clear();
+}
+
+template <FrontierOrder Order>
+void StateFrontier<Order>::reset(int)
+{
+    this->entries.clear();
+    this->head = 0;
+}
+
+// Getters
+template <FrontierOrder Order>
+bool StateFrontier<Order>::isEmpty()
+{
+    return this->head == this->entries.size();
+}
+
+template <FrontierOrder Order>
+int StateFrontier<Order>::getSize()
+{
+    return (int)(this->entries.size() - this->head);
+}
+
+template <FrontierOrder Order>
+bool StateFrontier<Order>::contains(int)
+{
+    return false;
+}
+
+// Operations
+template <FrontierOrder Order>
+void StateFrontier<Order>::push(int id, double, int value)
+{
+    this->entries.push_back({id, value});
+}
+
+// Sem prioridade não há o que diminuir: o estado entra de novo
+template <FrontierOrder Order>
+void StateFrontier<Order>::decrease(int id, double priority, int value)
+{
+    this->push(id, priority, value);
+}
+
+template <FrontierOrder Order>
+void StateFrontier<Order>::pop(int &id, int &value)
+{
+    Entry entry;
+    if (Order == FIRST_IN_FIRST_OUT)
+        entry = this->entries[this->head++];
+    else
+    {
+        entry = this->entries.back();
+        this->entries.pop_back();
+    }
+
+    id = entry.id;
+    value = entry.value;
+}
+
+#endif // STATEFRONTIER_H
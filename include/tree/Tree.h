@@ -4,79 +4,208 @@
 #ifndef TREE_H
 #define TREE_H
 
-#include "TreeNode.h"
+#include "BucketQueue.h"
+#include "IndexedHeap.h"
+#include "JumpTable.h"
+#include "PathCache.h"
+#include "SearchContext.h"
+#include "SearchPolicy.h"
+#include "StateFrontier.h"
+#include "../maze/Edge.h"
 #include "../maze/Graph.h"
+#include "../maze/GridMaze.h"
+#include "../maze/Heuristic.h"
+#include "../perf/perf.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <stack>
 #include <queue>
+#include <unordered_set>
+#include <vector>
 
 using namespace std;
 
-struct CompareCost
+// Buscas disponíveis, com os mesmos números do menu
+enum SearchAlgorithm
 {
-    bool operator()(TreeNode *a, TreeNode *b)
-    {
-        return a->getCost() > b->getCost();
-    }
+    BACKTRACKING_SEARCH = 1,
+    BREADTH_FIRST_SEARCH,
+    DEPTH_FIRST_SEARCH,
+    GREEDY_SEARCH,
+    UNIFORM_COST_SEARCH,
+    A_STAR_SEARCH,
+    JUMP_POINT_SEARCH,
+    BIDIRECTIONAL_BREADTH_FIRST_SEARCH,
+    BIDIRECTIONAL_A_STAR_SEARCH,
+    ITERATIVE_DEEPENING_A_STAR_SEARCH,
+    ANYTIME_A_STAR_SEARCH
 };
 
-struct CompareFScore
+// Lista de abertos da busca de custo uniforme e do A*
+enum OpenListType
 {
-    bool operator()(TreeNode *a, TreeNode *b)
-    {
-        return a->getFScore() > b->getFScore();
-    }
+    AUTOMATIC_OPEN_LIST, // Fila de baldes se os pesos forem inteiros pequenos, senão heap
+    HEAP_OPEN_LIST,
+    BUCKET_OPEN_LIST
 };
 
+// Árvore de busca guardada em vetores paralelos indexados pelo estado (0 é a raiz): nó do
+// labirinto, pai, direção usada e flags em um byte, custo g e fScore. São 25 bytes por estado
+// gerado, contra os mais de 200 de um nó com ponteiros para os filhos e 4 regras guardadas.
+//
+// Os filhos não são guardados; traverseAndPrint os reconstrói a partir dos pais só quando a
+// árvore é exportada. Das regras disponíveis fica apenas uma máscara de 4 bits, e o vetor de
+// regras é recalculado a partir do labirinto quando o estado é revisitado.
 class Tree
 {
 
 private:
-    TreeNode *root;          // Raíz da árvore
+    vector<int> mazeIds;     // Nó do labirinto de cada estado
+    vector<int> parents;     // Estado pai (-1 na raiz)
+    vector<uint8_t> flags;   // Bits 0-1: direção usada, 2: raiz, 3: backtracking, 4-7: regras disponíveis
+    vector<double> costs;    // Custo acumulado
+    vector<double> fScores;  // Custo + heurística
+    vector<int> children;    // 4 filhos por estado (por direção), montado só para a exportação
+    int finalState;          // Estado final da última busca (-1 se não achou)
     int statesNumber;        // Número de estados
     int visitedStatesNumber; // Número de estados explorados
+    SearchContext ownContext; // Contexto usado quando nenhum outro é informado
+    SearchContext *context;   // Estado da busca atual (visitados, custos, pais)
+    StateFrontier<FIRST_IN_FIRST_OUT> queueOpenList; // Abertos da busca em largura
+    StateFrontier<LAST_IN_FIRST_OUT> stackOpenList;  // Abertos da busca em profundidade e da gulosa
+    IndexedHeap heapOpenList;     // Abertos da busca de custo uniforme e do A*
+    BucketQueue bucketOpenList;   // Abertos das mesmas buscas com pesos inteiros pequenos
+    OpenListType openListType;    // Escolha entre os dois
+    SearchContext reverseContext;     // Metade das buscas bidirecionais que parte do objetivo
+    IndexedHeap reverseHeapOpenList;  // Abertos dessa metade no A* bidirecional
+    double timeBudget;                // Prazo do A* anytime, em segundos
+    double suboptimalityBound;        // Custo achado pelo A* anytime / custo ótimo, no máximo
+    PathCache *pathCache;             // Resultados já calculados consultados por search (ou nulo)
+    JumpTable ownJumpTable;           // Pontos de salto usados quando nenhuma tabela é informada
+    JumpTable *jumpTable;             // Pontos de salto do Jump Point Search
+
+    void beginSearch(int nodeCount);
+    template <class Maze>
+    bool useBucketQueue(Maze *maze);
+    template <class Policy, class Maze, class Frontier>
+    stack<int> frontierSearch(Maze *maze, Frontier &frontier);
+    template <class Maze, class OpenList>
+    stack<int> jumpSearch(Maze *maze, OpenList &openList);
+    void buildChildren();
+    stack<int> buildSolution(int state);
+    template <class Maze>
+    stack<int> buildJumpSolution(Maze *maze, int state);
+    stack<int> buildBidirectionalSolution(int meetingMazeNodeId);
+    void removeLastState();
 
 public:
     Tree();
     ~Tree();
 
     // Operations
-    void insert(TreeNode *currentState, TreeNode *newTreeNode, Edge *chosenEdge);
-    void insertRoot(TreeNode *rootNode);
-    void remove(TreeNode *node);
+    int insert(int currentState, Edge &chosenEdge);
+    int insertRoot(int mazeId);
     void clearTree();
 
     // Getters
-    TreeNode *getRoot();
+    int getRoot();
+    int getSize();
+    int getMazeId(int state);
+    int getParent(int state);
+    int getUsedDirection(int state);
+    int getAvailableRulesMask(int state);
+    bool getBacktracked(int state);
+    bool isFinal(int state);
+    double getCost(int state);
+    double getFScore(int state);
+    SearchContext *getSearchContext();
+    OpenListType getOpenListType();
+    double getTimeBudget();
+    double getSuboptimalityBound();
+    PathCache *getPathCache();
+
+    // Setters
+    void setAvailableRules(int state, Edge rules[4]);
+    void setBacktracked(int state, bool backtracked);
+    void setFinal(int state);
+    void setCost(int state, double cost);
+    void setFScore(int state, double fScore);
+    void setSearchContext(SearchContext *context);
+    void setOpenListType(OpenListType openListType);
+    void setPathCache(PathCache *pathCache);
+    void setJumpTable(JumpTable *jumpTable);
+    void setTimeBudget(double timeBudget);
 
     // Aux
     int getStatesNumber();
     int getVisitedStatesNumber();
-    void traverseAndPrint(TreeNode *node, string &dot);
+    void traverseAndPrint(int root, ostream &output);
 
     // Searches
-    stack<TreeNode *> backtrackingSearch(Graph *maze);
-    stack<TreeNode *> breadthFirstSearch(Graph *maze);
-    stack<TreeNode *> depthFirstSearch(Graph *maze);
-    stack<TreeNode *> greedySearch(Graph *maze);
-    stack<TreeNode *> uniformCostSearch(Graph *maze);
-    stack<TreeNode *> aStarSearch(Graph *maze);
+    // Maze pode ser qualquer labirinto com a interface de busca de Graph/GridMaze:
+    // getNodeCount, getStartId, isFinal, getHeuristic e getEdges (as bidirecionais também
+    // usam getGoalId, getX e getY). O labirinto só é lido;
+    // todo o estado da busca fica no SearchContext da árvore. As buscas devolvem os ids
+    // dos nós do labirinto no caminho, com o inicial no topo da pilha
+    template <class Maze>
+    stack<int> backtrackingSearch(Maze *maze);
+    template <class Maze>
+    stack<int> breadthFirstSearch(Maze *maze);
+    template <class Maze>
+    stack<int> depthFirstSearch(Maze *maze);
+    template <class Maze>
+    stack<int> greedySearch(Maze *maze);
+    template <class Maze>
+    stack<int> uniformCostSearch(Maze *maze);
+    template <class Maze>
+    stack<int> aStarSearch(Maze *maze);
+    template <class Maze>
+    stack<int> jumpPointSearch(Maze *maze);
+    template <class Maze>
+    stack<int> bidirectionalBreadthFirstSearch(Maze *maze);
+    template <class Maze>
+    stack<int> bidirectionalAStarSearch(Maze *maze);
+    template <class Maze>
+    stack<int> iterativeDeepeningAStarSearch(Maze *maze);
+    template <class Maze>
+    stack<int> anytimeAStarSearch(Maze *maze);
+    template <class Maze>
+    stack<int> search(SearchAlgorithm algorithm, Maze *maze);
 };
 
 // Construtor
 Tree::Tree()
 {
-    this->root = nullptr;
+    this->finalState = -1;
     this->statesNumber = 0;
     this->visitedStatesNumber = 0;
+    this->context = &this->ownContext;
+    this->openListType = AUTOMATIC_OPEN_LIST;
+    this->timeBudget = 0.1;
+    this->suboptimalityBound = 1;
+    this->pathCache = nullptr;
+    this->jumpTable = &this->ownJumpTable;
 }
 
 // Destrutor
 Tree::~Tree()
 {
-    this->root = nullptr;
+    this->finalState = -1;
     this->statesNumber = -1;
     this->visitedStatesNumber = -1;
+    this->context = nullptr;
+}
+
+// Zera os contadores, descarta a árvore anterior e prepara o contexto para uma nova busca
+void Tree::beginSearch(int nodeCount)
+{
+    this->clearTree();
+    this->statesNumber = 0;
+    this->visitedStatesNumber = 0;
+    this->context->reset(nodeCount);
 }
 
 int Tree::getStatesNumber()
@@ -89,128 +218,304 @@ int Tree::getVisitedStatesNumber()
     return this->visitedStatesNumber;
 }
 
-void Tree::insertRoot(TreeNode *rootNode)
+int Tree::insertRoot(int mazeId)
 {
-    this->root = rootNode;
+    this->mazeIds.push_back(mazeId);
+    this->parents.push_back(-1);
+    this->flags.push_back(1 << 2);
+    this->costs.push_back(0);
+    this->fScores.push_back(0);
+    return (int)this->mazeIds.size() - 1;
 }
 
-void Tree::traverseAndPrint(TreeNode *node, string &dot)
+// Monta os filhos de cada estado, na posição da direção usada para chegar a eles
+void Tree::buildChildren()
 {
-    if (node == nullptr)
-        return;
+    this->children.assign(this->mazeIds.size() * 4, -1);
+    for (int state = 1; state < (int)this->mazeIds.size(); state++)
+        if (this->parents[state] >= 0)
+            this->children[this->parents[state] * 4 + this->getUsedDirection(state)] = state;
+}
 
-    // Print the current node
+// Escreve a subárvore de root no formato DOT na ordem de uma travessia recursiva (o estado,
+// as subárvores dos filhos e depois as arestas para eles), mas sem recursão e sem pilha: ao
+// terminar um estado, volta ao pai e segue pela direção seguinte à que levou ao estado. Só o
+// vetor de filhos é montado, então árvores profundas não estouram a pilha de chamadas
+void Tree::traverseAndPrint(int root, ostream &output)
+{
+    if (root < 0)
+        return;
 
-    dot += "  " + to_string(node->getId()) + " [label=\"" + to_string(node->getId()) + "\"";
+    if (this->children.size() != this->mazeIds.size() * 4)
+        this->buildChildren();
 
-    if (node->isFinal())
-        dot += ", color = green];\n";
-    else
-        dot += "];\n";
-
-    // Recursively traverse children
-    traverseAndPrint(node->getTopChild(), dot);
-    traverseAndPrint(node->getLeftChild(), dot);
-    traverseAndPrint(node->getDownChild(), dot);
-    traverseAndPrint(node->getRightChild(), dot);
-
-    // Print edges
-    if (node->getTopChild() != nullptr)
-        dot += "  " + to_string(node->getId()) + " -> " + to_string(node->getTopChild()->getId()) + " [label=\"" + to_string(node->getTopChild()->getUsedEdge()->getDirection()) + "\"];\n";
-    if (node->getLeftChild() != nullptr)
-        dot += "  " + to_string(node->getId()) + " -> " + to_string(node->getLeftChild()->getId()) + " [label=\"" + to_string(node->getLeftChild()->getUsedEdge()->getDirection()) + "\"];\n";
-    if (node->getDownChild() != nullptr)
-        dot += "  " + to_string(node->getId()) + " -> " + to_string(node->getDownChild()->getId()) + " [label=\"" + to_string(node->getDownChild()->getUsedEdge()->getDirection()) + "\"];\n";
-    if (node->getRightChild() != nullptr)
-        dot += "  " + to_string(node->getId()) + " -> " + to_string(node->getRightChild()->getId()) + " [label=\"" + to_string(node->getRightChild()->getUsedEdge()->getDirection()) + "\"];\n";
-
-    if (node->getBacktracked())
+    int state = root;
+    int direction = -1; // Próximo filho a visitar (cima, esquerda, baixo, direita); -1 ao chegar no estado
+    while (true)
     {
-        TreeNode *father = node->getFather();
-        if (father != nullptr)
-            dot += "  " + to_string(node->getId()) + " -> " + to_string(father->getId()) + " [label=\"backtracked\"];\n";
+        int mazeId = this->getMazeId(state);
+        int *stateChildren = &this->children[state * 4];
+
+        // Print the current node
+        if (direction < 0)
+        {
+            output << "  " << mazeId << " [label=\"" << mazeId << "\""
+                   << (this->isFinal(state) ? ", color = green];\n" : "];\n");
+            direction = 0;
+        }
+
+        // Desce para o próximo filho
+        while (direction < 4 && stateChildren[direction] < 0)
+            direction++;
+        if (direction < 4)
+        {
+            state = stateChildren[direction];
+            direction = -1;
+            continue;
+        }
+
+        // Print edges
+        for (int childDirection = 0; childDirection < 4; childDirection++)
+        {
+            int child = stateChildren[childDirection];
+            if (child >= 0)
+                output << "  " << mazeId << " -> " << this->getMazeId(child) << " [label=\"" << childDirection << "\"];\n";
+        }
+
+        int father = this->getParent(state);
+        if (this->getBacktracked(state) && father >= 0)
+            output << "  " << mazeId << " -> " << this->getMazeId(father) << " [label=\"backtracked\"];\n";
+
+        if (state == root)
+            return;
+
+        direction = this->getUsedDirection(state) + 1;
+        state = father;
     }
 }
 
-TreeNode *Tree::getRoot()
+// Getters
+int Tree::getRoot()
 {
-    return this->root;
+    return this->mazeIds.empty() ? -1 : 0;
 }
 
-void Tree::insert(TreeNode *currentState, TreeNode *newTreeNode, Edge *chosenEdge)
+int Tree::getSize()
 {
+    return (int)this->mazeIds.size();
+}
 
-    // Seta pai
-    newTreeNode->setFather(currentState);
+int Tree::getMazeId(int state)
+{
+    return this->mazeIds[state];
+}
 
-    // Seta filho de acordo com a regra usada
-    int directionTaken = chosenEdge->getDirection();
-    switch (directionTaken)
-    {
+int Tree::getParent(int state)
+{
+    return this->parents[state];
+}
 
-    case 0:
-        currentState->setTopChild(newTreeNode);
-        break;
+// Direção da aresta usada para chegar ao estado (-1 na raiz)
+int Tree::getUsedDirection(int state)
+{
+    if (this->flags[state] & (1 << 2))
+        return -1;
+    return this->flags[state] & 3;
+}
 
-    case 1:
-        currentState->setLeftChild(newTreeNode);
-        break;
+// Máscara das regras ainda disponíveis: bit i -> posição i do vetor de regras
+int Tree::getAvailableRulesMask(int state)
+{
+    return this->flags[state] >> 4;
+}
 
-    case 2:
-        currentState->setDownChild(newTreeNode);
-        break;
+bool Tree::getBacktracked(int state)
+{
+    return (this->flags[state] >> 3) & 1;
+}
 
-    case 3:
-        currentState->setRightChild(newTreeNode);
-        break;
-    }
+bool Tree::isFinal(int state)
+{
+    return state == this->finalState;
+}
 
-    this->statesNumber++;
-    newTreeNode->setUsedEdge(chosenEdge);
+double Tree::getCost(int state)
+{
+    return this->costs[state];
 }
 
-void Tree::remove(TreeNode *node)
+double Tree::getFScore(int state)
 {
-    int rule = node->getUsedEdge()->getDirection();
+    return this->fScores[state];
+}
 
-    switch (rule)
-    {
-    case 0:
-        node->getFather()->setTopChild(nullptr);
-        break;
+SearchContext *Tree::getSearchContext()
+{
+    return this->context;
+}
 
-    case 1:
-        node->getFather()->setLeftChild(nullptr);
-        break;
+OpenListType Tree::getOpenListType()
+{
+    return this->openListType;
+}
 
-    case 2:
-        node->getFather()->setDownChild(nullptr);
-        break;
+double Tree::getTimeBudget()
+{
+    return this->timeBudget;
+}
 
-    case 3:
-        node->getFather()->setRightChild(nullptr);
-        break;
-    }
+// Limite da última busca anytime: o caminho devolvido custa no máximo isso vezes o ótimo
+// (1 quando ele é ótimo, infinito quando nenhum caminho foi achado)
+double Tree::getSuboptimalityBound()
+{
+    return this->suboptimalityBound;
+}
+
+PathCache *Tree::getPathCache()
+{
+    return this->pathCache;
+}
+
+// Setters
+void Tree::setAvailableRules(int state, Edge rules[4])
+{
+    int mask = 0;
+    for (int i = 0; i < 4; i++)
+        if (rules[i].isValid())
+            mask |= 1 << i;
+
+    this->flags[state] = (uint8_t)((this->flags[state] & 0x0F) | (mask << 4));
+}
+
+void Tree::setBacktracked(int state, bool backtracked)
+{
+    if (backtracked)
+        this->flags[state] |= (uint8_t)(1 << 3);
+    else
+        this->flags[state] &= (uint8_t)~(1 << 3);
+}
+
+void Tree::setFinal(int state)
+{
+    this->finalState = state;
+}
+
+void Tree::setCost(int state, double cost)
+{
+    this->costs[state] = cost;
+}
+
+void Tree::setFScore(int state, double fScore)
+{
+    this->fScores[state] = fScore;
+}
+
+// Usa um contexto externo; cada busca simultânea no mesmo labirinto precisa do seu
+void Tree::setSearchContext(SearchContext *context)
+{
+    this->context = context != nullptr ? context : &this->ownContext;
+}
+
+void Tree::setOpenListType(OpenListType openListType)
+{
+    this->openListType = openListType;
+}
+
+// Com um cache, search devolve o caminho guardado quando a mesma consulta se repete sem o
+// labirinto mudar; nesse caso a árvore fica vazia. Nulo desliga o cache
+void Tree::setPathCache(PathCache *pathCache)
+{
+    this->pathCache = pathCache;
+}
 
-    node = nullptr;
+// Com uma tabela externa, os pontos de salto calculados em uma busca servem às seguintes no
+// mesmo labirinto; sem ela, a tabela própria é refeita a cada busca
+void Tree::setJumpTable(JumpTable *jumpTable)
+{
+    this->jumpTable = jumpTable != nullptr ? jumpTable : &this->ownJumpTable;
+}
+
+void Tree::setTimeBudget(double timeBudget)
+{
+    this->timeBudget = timeBudget;
 }
 
+// Cria o estado alcançado pela aresta escolhida a partir do estado atual
+int Tree::insert(int currentState, Edge &chosenEdge)
+{
+    this->mazeIds.push_back(chosenEdge.getTargetId());
+    this->parents.push_back(currentState);
+    this->flags.push_back((uint8_t)(chosenEdge.getDirection() & 3));
+    this->costs.push_back(0);
+    this->fScores.push_back(0);
+
+    this->statesNumber++;
+    return (int)this->mazeIds.size() - 1;
+}
+
+// Remove o último estado criado (o IDA* usa a árvore como a pilha do caminho atual)
+void Tree::removeLastState()
+{
+    this->mazeIds.pop_back();
+    this->parents.pop_back();
+    this->flags.pop_back();
+    this->costs.pop_back();
+    this->fScores.pop_back();
+}
+
+// Descarta a árvore; os vetores mantêm a capacidade para a próxima busca
 void Tree::clearTree()
 {
-    this->root = nullptr;
+    this->mazeIds.clear();
+    this->parents.clear();
+    this->flags.clear();
+    this->costs.clear();
+    this->fScores.clear();
+    this->children.clear();
+    this->finalState = -1;
 }
 
-void sortArray(Edge *edges[], int numEdges)
+// Coloca os nós do caminho até o estado em uma pilha, com o inicial no topo
+stack<int> Tree::buildSolution(int state)
+{
+    stack<int> pilha;
+    while (state >= 0)
+    {
+        pilha.push(this->mazeIds[state]);
+        state = this->parents[state];
+    }
+    return pilha;
+}
+
+// Caminho das buscas bidirecionais: os pais de cada metade ficam no seu contexto, então o
+// caminho é o do início até o nó de encontro seguido do encontro até o objetivo
+stack<int> Tree::buildBidirectionalSolution(int meetingMazeNodeId)
+{
+    stack<int> pilha;
+
+    vector<int> reversePath;
+    for (int id = meetingMazeNodeId; id >= 0; id = this->reverseContext.getParent(id))
+        reversePath.push_back(id);
+    for (int i = (int)reversePath.size() - 1; i >= 0; i--)
+        pilha.push(reversePath[i]);
+
+    for (int id = this->context->getParent(meetingMazeNodeId); id >= 0; id = this->context->getParent(id))
+        pilha.push(id);
+
+    return pilha;
+}
+
+void sortArray(Edge edges[], int numEdges)
 {
     // Bubble sort
     for (int i = 0; i < numEdges - 1; i++)
     {
         for (int j = 0; j < numEdges - i - 1; j++)
         {
-            if (edges[j] != nullptr && edges[j + 1] != nullptr &&
-                edges[j]->getDirection() > edges[j + 1]->getDirection())
+            if (edges[j].isValid() && edges[j + 1].isValid() &&
+                edges[j].getDirection() > edges[j + 1].getDirection())
             {
-                Edge *temp = edges[j];
+                Edge temp = edges[j];
                 edges[j] = edges[j + 1];
                 edges[j + 1] = temp;
             }
@@ -218,78 +523,79 @@ void sortArray(Edge *edges[], int numEdges)
     }
 }
 
-Edge **getAvailableRules(Node *currentMazeNode, TreeNode *currentState)
+// Preenche availableRules com as regras aplicáveis ao estado atual (sem contexto, todas as
+// regras menos a de volta)
+template <class Maze>
+void getAvailableRules(Maze *maze, SearchContext *context, Tree *tree, int currentMazeNodeId, int currentState, Edge availableRules[4])
 {
-    // Vetor de regras possíveis aplicáveis
-    Edge **availableRules = new Edge *[4];
-
-    Edge *usedRule = currentState->getUsedEdge();
-
-    // Se o nó do labirinto não foi visitado ainda, é necessário setar as suas regras disponiveis
-    if (!(currentMazeNode->getVisited()))
+    // Se o nó do labirinto já foi visitado, valem só as regras que ainda restam no estado
+    int remaining = 0xF;
+    if (context != nullptr && context->getVisited(currentMazeNodeId))
     {
-        for (int i = 0; i < 4; i++)
+        remaining = tree->getAvailableRulesMask(currentState);
+        if (remaining == 0)
         {
-            availableRules[i] = nullptr;
+            for (int i = 0; i < 4; i++)
+                availableRules[i] = Edge();
+            return;
         }
+    }
 
-        Edge *edge = currentMazeNode->getFirstEdge();
+    // Nó do labirinto de onde o estado veio (-1 na raiz)
+    int parentState = tree->getParent(currentState);
+    int parentMazeNodeId = parentState >= 0 ? tree->getMazeId(parentState) : -1;
 
-        int index = 0;
+    Edge edges[4];
+    int numEdges = maze->getEdges(currentMazeNodeId, edges);
 
-        // Preenche vetor de regras com as arestas que saem daquele nó
-        while (edge != nullptr && index < 4)
-        {
-            if (usedRule != nullptr)
-            {
-                // evita que um nó possua uma aresta para onde veio
-                if (!((edge->getDirection() == 0 && usedRule->getDirection() == 2) || ((edge->getDirection() == 1 && usedRule->getDirection() == 3)) || ((edge->getDirection() == 2 && usedRule->getDirection() == 0)) || ((edge->getDirection() == 3 && usedRule->getDirection() == 1))))
-                {
-                    availableRules[index] = edge;
-                }
-            }
-            else
-                availableRules[index] = edge;
+    // Preenche vetor de regras com as arestas que saem daquele nó
+    for (int index = 0; index < 4; index++)
+    {
+        availableRules[index] = Edge();
 
-            index++;
-            edge = edge->getNextEdge();
-        }
+        if (index >= numEdges)
+            continue;
 
-        // Ordena vetor de regras em ordem crescente (você deve implementar a função de ordenação)
-        sortArray(availableRules, 4);
-    }
-    else
-    {
-        // Se o nó ja foi visitado, ele precisa apenas puxar de suas propriedades as regras disponiveis.
-        availableRules = currentState->getAvailableRules();
+        // evita que um nó possua uma aresta para onde veio. Compara o destino e não a direção:
+        // no labirinto de corredores contraídos a aresta chega por um lado diferente do que saiu
+        if (edges[index].getTargetId() != parentMazeNodeId)
+            availableRules[index] = edges[index];
     }
-    return availableRules;
+
+    // Ordena vetor de regras em ordem crescente (você deve implementar a função de ordenação)
+    sortArray(availableRules, 4);
+
+    // Descarta as regras que o estado já usou
+    for (int i = 0; i < 4; i++)
+        if (!((remaining >> i) & 1))
+            availableRules[i] = Edge();
 }
 
-stack<TreeNode *> Tree::backtrackingSearch(Graph *maze)
+template <class Maze>
+stack<int> Tree::backtrackingSearch(Maze *maze)
 {
-    stack<TreeNode *> pilha;
+    stack<int> pilha;
 
-    if (maze->getFirstNode() == nullptr)
+    if (maze->getNodeCount() == 0)
         return pilha;
 
-    // pega id do primeiro nó do labirinto == estado inicial
-    Node *currentMazeNode = maze->getFirstNode();
+    this->beginSearch(maze->getNodeCount());
 
-    TreeNode *currentState = new TreeNode(currentMazeNode->getId());
+    // pega id do primeiro nó do labirinto == estado inicial
+    int currentMazeNodeId = maze->getStartId();
 
-    insertRoot(currentState);
+    int currentState = insertRoot(currentMazeNodeId);
 
-    Edge *chosenEdge = nullptr;
+    Edge availableRules[4];
 
-    while (currentMazeNode->getTag() != "final")
+    while (!maze->isFinal(currentMazeNodeId))
     {
-        Edge **availableRules = getAvailableRules(currentMazeNode, currentState);
+        getAvailableRules(maze, this->context, this, currentMazeNodeId, currentState, availableRules);
 
-        currentState->setAvailableRules(availableRules);
+        this->setAvailableRules(currentState, availableRules);
 
         // nó puxou as regras, logo foi visitado
-        currentMazeNode->setVisited();
+        this->context->setVisited(currentMazeNodeId);
         this->visitedStatesNumber++;
 
         // contador para verificar se todas as regras são nulas, pois se forem é necessário retornar para o pai
@@ -297,30 +603,24 @@ stack<TreeNode *> Tree::backtrackingSearch(Graph *maze)
 
         for (int i = 0; i < 4; i++)
         {
-            if (availableRules[i] != nullptr)
+            if (availableRules[i].isValid())
             {
-                chosenEdge = availableRules[i];
-
-                // Cria novo nó cujo id é o nó destino daquela aresta no grafo
-                TreeNode *newTreeNode = new TreeNode(chosenEdge->getTargetId());
+                Edge chosenEdge = availableRules[i];
 
-                // Insere novo nó na árvore
-                this->insert(currentState, newTreeNode, chosenEdge);
+                // Insere na árvore o estado cujo id é o nó destino daquela aresta no grafo
+                int newState = this->insert(currentState, chosenEdge);
 
                 // Remove aquela regra da lista de possíveis
-                availableRules[i] = nullptr;
+                availableRules[i] = Edge();
 
-                // Seta regras disponíveis daquele novo nó
-                currentState->setAvailableRules(availableRules);
-
-                // Marca a aresta utilizada para chegar até o novo nó
-                newTreeNode->setUsedEdge(chosenEdge);
+                // Seta regras disponíveis do estado atual
+                this->setAvailableRules(currentState, availableRules);
 
                 // Troca nó atual do grafo de acordo com a aresta tomada
-                currentMazeNode = maze->getNodeById(chosenEdge->getTargetId());
+                currentMazeNodeId = chosenEdge.getTargetId();
 
                 // Troca nó atual da árvore
-                currentState = newTreeNode;
+                currentState = newState;
 
                 // Pŕoxima iteração
                 break;
@@ -331,472 +631,1069 @@ stack<TreeNode *> Tree::backtrackingSearch(Graph *maze)
         // Se contador == 4 quer dizer que não existe regra disponivel, logo é nescessário dar rollback
         if (count == 4)
         {
-            currentState->setBacktracked(true);
-            currentState = currentState->getFather();
-            currentMazeNode = maze->getNodeById(currentState->getId());
+            // Voltou até a raiz sem regras: o objetivo não é alcançável
+            if (this->getParent(currentState) < 0)
+                return pilha;
+
+            this->setBacktracked(currentState, true);
+            currentState = this->getParent(currentState);
+            currentMazeNodeId = this->getMazeId(currentState);
 
             // corrigir problema do numero de estados visitados
             this->visitedStatesNumber--;
         }
     }
 
-    currentState->setFinal();
+    this->setFinal(currentState);
 
     // coloca todos os nós da busca solução em uma pilha
-    while (currentState != this->root)
+    return this->buildSolution(currentState);
+}
+
+void printAvailableRules(Edge availableRules[4])
+{
+    cout << "Available Rules: ";
+    for (int i = 0; i < 4; i++)
     {
-        pilha.push(currentState);
-        currentState = currentState->getFather();
+        if (availableRules[i].isValid())
+        {
+            cout << "[" << availableRules[i].getSourceId() << " - " << availableRules[i].getTargetId() << "] ";
+        }
     }
-    // add nó inicial
-    pilha.push(currentState);
+    cout << endl;
+}
 
-    return pilha;
+void printStack(stack<int> pilha)
+{
+    cout << "Stack: ";
+    while (!pilha.empty())
+    {
+        int id = pilha.top();
+        pilha.pop();
+
+        if (pilha.size() != 0)
+        {
+            cout << id << " -> ";
+        }
+        else
+            cout << id << " ";
+    }
+    cout << " ___ " << endl;
 }
 
-stack<TreeNode *> Tree::breadthFirstSearch(Graph *maze)
+// Busca com fronteira, comum às buscas em largura, em profundidade, gulosa, de custo uniforme
+// e A*. Policy (SearchPolicy.h) dá a prioridade de cada nó, a ordem dos filhos e se os custos
+// são acompanhados; Frontier é a StateFrontier (fila ou pilha), o IndexedHeap ou a
+// BucketQueue, que têm a mesma interface. Com custos, os abertos são indexados pelo nó do
+// labirinto: cada nó entra uma vez e só tem a prioridade diminuída
+template <class Policy, class Maze, class Frontier>
+stack<int> Tree::frontierSearch(Maze *maze, Frontier &frontier)
 {
-    stack<TreeNode *> pilha;
+    stack<int> pilha;
 
-    if (maze->getFirstNode() == nullptr)
+    if (maze->getNodeCount() == 0)
         return pilha;
 
-    Node *currentMazeNode = maze->getFirstNode();
+    this->beginSearch(maze->getNodeCount());
 
-    TreeNode *currentState = new TreeNode(currentMazeNode->getId());
+    // pega id do primeiro nó do labirinto == estado inicial
+    int currentMazeNodeId = maze->getStartId();
 
-    insertRoot(currentState);
+    int currentState = insertRoot(currentMazeNodeId);
+    if (Policy::TRACK_COSTS)
+    {
+        this->setFScore(currentState, Policy::getPriority(maze, currentMazeNodeId, 0));
+        this->context->setReached(currentMazeNodeId, 0, -1);
+    }
 
-    queue<TreeNode *> abertos;
+    frontier.reset(maze->getNodeCount());
 
-    Edge *chosenEdge = nullptr;
+    Edge availableRules[4];
 
-    while (currentMazeNode->getTag() != "final")
+    while (!maze->isFinal(currentMazeNodeId))
     {
-        Edge **availableRules = getAvailableRules(currentMazeNode, currentState);
+        getAvailableRules(maze, this->context, this, currentMazeNodeId, currentState, availableRules);
+        Policy::orderRules(maze, availableRules);
 
-        currentState->setAvailableRules(availableRules);
+        this->setAvailableRules(currentState, availableRules);
 
         // nó puxou as regras, logo foi visitado
-        currentMazeNode->setVisited();
+        this->context->setVisited(currentMazeNodeId);
         this->visitedStatesNumber++;
 
         for (int i = 0; i < 4; i++)
         {
-            if (availableRules[i] != nullptr)
-            {
-                chosenEdge = availableRules[i];
+            if (!availableRules[i].isValid())
+                continue;
 
-                // Cria novo nó cujo id é o nó destino daquela aresta no grafo
-                TreeNode *newTreeNode = new TreeNode(chosenEdge->getTargetId());
+            Edge &chosenEdge = availableRules[i];
+            int targetId = chosenEdge.getTargetId();
 
-                // Insere novo nó na árvore
-                this->insert(currentState, newTreeNode, chosenEdge);
+            // Custo acumulado até o nó destino por este caminho
+            double cost = 0;
+            if (Policy::TRACK_COSTS)
+            {
+                cost = this->getCost(currentState) + chosenEdge.getWeight();
 
-                // Marca a aresta utilizada para chegar até o novo nó
-                newTreeNode->setUsedEdge(chosenEdge);
+                // Nó já expandido ou já alcançado por um caminho tão barato quanto este
+                if (this->context->getVisited(targetId) || cost >= this->context->getCost(targetId))
+                    continue;
+            }
 
-                abertos.push(newTreeNode);
+            // Insere na árvore o estado cujo id é o nó destino daquela aresta no grafo
+            int newState = this->insert(currentState, chosenEdge);
+            double priority = Policy::getPriority(maze, targetId, cost);
+            if (Policy::TRACK_COSTS)
+            {
+                this->setCost(newState, cost);
+                this->setFScore(newState, priority);
+                this->context->setReached(targetId, cost, currentMazeNodeId);
             }
+
+            if (frontier.contains(targetId))
+                frontier.decrease(targetId, priority, newState);
+            else
+                frontier.push(targetId, priority, newState);
         }
-        currentState = abertos.front();
-        abertos.pop();
-        currentMazeNode = maze->getNodeById(currentState->getId());
+
+        // Fronteira vazia: o objetivo não é alcançável
+        if (frontier.isEmpty())
+            return pilha;
+
+        frontier.pop(currentMazeNodeId, currentState);
     }
 
     // nó final
     this->visitedStatesNumber++;
 
-    currentState->setFinal();
+    this->setFinal(currentState);
 
     // coloca todos os nós da busca solução em uma pilha
-    while (currentState != this->root)
+    return this->buildSolution(currentState);
+}
+
+// Fila de baldes quando os pesos são inteiros pequenos (ou quando ela foi escolhida e os
+// pesos são inteiros); heap indexado nos outros casos
+template <class Maze>
+bool Tree::useBucketQueue(Maze *maze)
+{
+    int maxWeight = maze->getMaxIntegerWeight();
+
+    switch (this->openListType)
     {
-        pilha.push(currentState);
-        currentState = currentState->getFather();
+    case HEAP_OPEN_LIST:
+        return false;
+    case BUCKET_OPEN_LIST:
+        return maxWeight >= 0;
+    default:
+        return maxWeight >= 0 && maxWeight <= BucketQueue::MAX_WEIGHT;
     }
-    // add nó inicial
-    pilha.push(currentState);
-
-    return pilha;
 }
 
-stack<TreeNode *> Tree::depthFirstSearch(Graph *maze)
+template <class Maze>
+stack<int> Tree::breadthFirstSearch(Maze *maze)
 {
-    stack<TreeNode *> pilha;
+    return this->frontierSearch<UnorderedPolicy>(maze, this->queueOpenList);
+}
 
-    if (maze->getFirstNode() == nullptr)
-        return pilha;
+template <class Maze>
+stack<int> Tree::depthFirstSearch(Maze *maze)
+{
+    return this->frontierSearch<UnorderedPolicy>(maze, this->stackOpenList);
+}
 
-    // pega id do primeiro nó do labirinto == estado inicial
-    Node *currentMazeNode = maze->getFirstNode();
+template <class Maze>
+stack<int> Tree::greedySearch(Maze *maze)
+{
+    return this->frontierSearch<HeuristicOrderPolicy>(maze, this->stackOpenList);
+}
 
-    TreeNode *currentState = new TreeNode(currentMazeNode->getId());
+template <class Maze>
+stack<int> Tree::uniformCostSearch(Maze *maze)
+{
+    if (this->useBucketQueue(maze))
+        return this->frontierSearch<CostPolicy>(maze, this->bucketOpenList);
+    return this->frontierSearch<CostPolicy>(maze, this->heapOpenList);
+}
 
-    insertRoot(currentState);
+template <class Maze>
+stack<int> Tree::aStarSearch(Maze *maze)
+{
+    if (this->useBucketQueue(maze))
+        return this->frontierSearch<CostPlusHeuristicPolicy>(maze, this->bucketOpenList);
+    return this->frontierSearch<CostPlusHeuristicPolicy>(maze, this->heapOpenList);
+}
 
-    stack<TreeNode *> abertos;
+// Vizinho do nó na direção dada, ou -1 se não há passagem nessa direção
+template <class Maze>
+int getNeighbourInDirection(Maze *maze, int mazeNodeId, int direction)
+{
+    Edge edges[4];
+    int numEdges = maze->getEdges(mazeNodeId, edges);
+    for (int i = 0; i < numEdges; i++)
+        if (edges[i].getDirection() == direction)
+            return edges[i].getTargetId();
+    return -1;
+}
 
-    Edge *chosenEdge = nullptr;
+// Direções 1 e 3 (esquerda e direita) são horizontais; 0 e 2 (cima e baixo), verticais
+bool isHorizontalDirection(int direction)
+{
+    return direction == 1 || direction == 3;
+}
 
-    while (currentMazeNode->getTag() != "final")
-    {
-        Edge **availableRules = getAvailableRules(currentMazeNode, currentState);
+// Poda do Jump Point Search em 4 direções, com a ordem canônica "horizontal primeiro": entre
+// caminhos de mesmo custo vale o que anda na horizontal antes de subir ou descer. Chegando ao
+// nó na horizontal, seguir em frente, subir e descer são naturais. Chegando na vertical, só
+// seguir em frente é natural; virar para o lado só é necessário (vizinho forçado) quando o
+// desvio canônico -- do nó anterior para o lado e depois na vertical -- está fechado.
+template <class Maze>
+bool isJumpRule(Maze *maze, int mazeNodeId, int usedDirection, int direction)
+{
+    if (usedDirection < 0 || direction == usedDirection || isHorizontalDirection(usedDirection))
+        return true;
+    if (!isHorizontalDirection(direction))
+        return false;
 
-        currentState->setAvailableRules(availableRules);
+    int previousId = getNeighbourInDirection(maze, mazeNodeId, (usedDirection + 2) % 4);
+    int cornerId = previousId >= 0 ? getNeighbourInDirection(maze, previousId, direction) : -1;
+    if (cornerId < 0)
+        return true;
 
-        // nó puxou as regras, logo foi visitado
-        currentMazeNode->setVisited();
-        this->visitedStatesNumber++;
+    return getNeighbourInDirection(maze, cornerId, usedDirection) != getNeighbourInDirection(maze, mazeNodeId, direction);
+}
 
-        for (int i = 0; i < 4; i++)
-        {
-            if (availableRules[i] != nullptr)
-            {
-                chosenEdge = availableRules[i];
+// Vizinhos do nó indexados pela direção, -1 onde não há passagem
+template <class Maze>
+void getNeighbours(Maze *maze, int mazeNodeId, int neighbours[4])
+{
+    Edge edges[4];
+    int numEdges = maze->getEdges(mazeNodeId, edges);
+    for (int direction = 0; direction < 4; direction++)
+        neighbours[direction] = -1;
+    for (int i = 0; i < numEdges; i++)
+        neighbours[edges[i].getDirection() & 3] = edges[i].getTargetId();
+}
 
-                // Cria novo nó cujo id é o nó destino daquela aresta no grafo
-                TreeNode *newTreeNode = new TreeNode(chosenEdge->getTargetId());
+// Ponto de salto da linha que sai do nó na direção dada, sem contar o objetivo: um nó com
+// vizinho forçado ou, andando na horizontal, um nó de onde um salto vertical acha um ponto de
+// salto. Devolve -1 se a linha termina antes; distance recebe o número de passos até o ponto
+// ou, sem ele, até o fim da linha.
+//
+// As condições de parada só olham o nó e o anterior na linha, então todo nó do caminho chega
+// ao mesmo ponto de salto; o resultado de cada um fica na tabela, e uma varredura que passa
+// por um nó já calculado nessa direção termina ali
+template <class Maze>
+int findJumpPoint(Maze *maze, JumpTable &table, int mazeNodeId, int direction, int &distance)
+{
+    int targetId = -1;
+    if (table.find(mazeNodeId, direction, targetId, distance))
+        return targetId;
+
+    bool horizontal = isHorizontalDirection(direction);
+    vector<int> &line = table.getLine(horizontal);
+    int previous[4], current[4];
+
+    line.clear();
+    line.push_back(mazeNodeId);
+    distance = 0;
+    getNeighbours(maze, mazeNodeId, previous);
+    int currentMazeNodeId = previous[direction];
+
+    // Limite de passos para grafos cujas direções não formam uma grade
+    for (int steps = maze->getNodeCount(); steps > 0 && currentMazeNodeId >= 0; steps--)
+    {
+        distance++;
 
-                // Insere novo nó na árvore
-                this->insert(currentState, newTreeNode, chosenEdge);
+        getNeighbours(maze, currentMazeNodeId, current);
 
-                // Marca a aresta utilizada para chegar até o novo nó
-                newTreeNode->setUsedEdge(chosenEdge);
+        int sides[2] = {(direction + 1) % 4, (direction + 3) % 4};
+        for (int side : sides)
+        {
+            if (current[side] < 0 || targetId >= 0)
+                continue;
 
-                abertos.push(newTreeNode);
+            if (horizontal)
+            {
+                int sideDistance;
+                if (findJumpPoint(maze, table, currentMazeNodeId, side, sideDistance) >= 0)
+                    targetId = currentMazeNodeId;
             }
+            // Vizinho forçado: o desvio pelo lado do nó anterior não chega nele
+            else if (previous[side] < 0 || getNeighbourInDirection(maze, previous[side], direction) != current[side])
+                targetId = currentMazeNodeId;
         }
-        currentState = abertos.top();
-        abertos.pop();
-        currentMazeNode = maze->getNodeById(currentState->getId());
-    }
+        if (targetId >= 0)
+            break;
 
-    // nó final
-    this->visitedStatesNumber++;
+        line.push_back(currentMazeNodeId);
 
-    currentState->setFinal();
+        // Resto da linha já calculado nessa direção
+        int remaining;
+        if (table.find(currentMazeNodeId, direction, targetId, remaining))
+        {
+            distance += remaining;
+            break;
+        }
 
-    // coloca todos os nós da busca solução em uma pilha
-    while (currentState != this->root)
-    {
-        pilha.push(currentState);
-        currentState = currentState->getFather();
+        for (int i = 0; i < 4; i++)
+            previous[i] = current[i];
+        currentMazeNodeId = current[direction];
     }
-    // add nó inicial
-    pilha.push(currentState);
 
-    return pilha;
+    for (int i = 0; i < (int)line.size(); i++)
+        table.insert(line[i], direction, targetId, distance - i);
+    return targetId;
 }
 
-void printAvailableRules(Edge **availableRules)
+// Passos do nó até o objetivo na direção dada (0: y + 1, 1: x - 1, 2: y - 1, 3: x + 1, como
+// no GridMaze) e o desvio dele para o lado, pelas coordenadas
+template <class Maze>
+void getGoalOffset(Maze *maze, int mazeNodeId, int direction, int &along, int &across)
 {
-    cout << "Available Rules: ";
-    for (int i = 0; i < 4; i++)
-    {
-        if (availableRules[i] != nullptr)
-        {
-            cout << "[" << availableRules[i]->getSourceId() << " - " << availableRules[i]->getTargetId() << "] ";
-        }
-    }
-    cout << endl;
+    int offsetX = maze->getX(maze->getGoalId()) - maze->getX(mazeNodeId);
+    int offsetY = maze->getY(maze->getGoalId()) - maze->getY(mazeNodeId);
+
+    along = direction == 0 ? offsetY : direction == 1 ? -offsetX : direction == 2 ? -offsetY : offsetX;
+    across = isHorizontalDirection(direction) ? offsetY : offsetX;
 }
 
-void orderByHeuristic(Edge **availableRules, Graph *maze)
+// Anda em linha reta a partir do nó até o próximo ponto de salto: o da tabela ou, se vier
+// antes na linha, o objetivo ou o nó na coluna do objetivo de onde um salto vertical chega
+// nele. Os nós no caminho não entram nos abertos. goalReach[d] é quantos passos o objetivo
+// anda na direção vertical d. Devolve -1 se não há ponto de salto; distance recebe o número
+// de passos
+template <class Maze>
+int jump(Maze *maze, JumpTable &table, int goalReach[4], int mazeNodeId, int direction, int &distance)
 {
+    int targetId = findJumpPoint(maze, table, mazeNodeId, direction, distance);
 
-    // Bubble sort
-    for (int i = 0; i < 4; i++)
+    int along, across;
+    getGoalOffset(maze, mazeNodeId, direction, along, across);
+    if (along < 1 || along > distance || (along == distance && targetId >= 0))
+        return targetId;
+
+    if (across == 0)
     {
-        for (int j = 0; j < 4 - i - 1; j++)
-        {
-            if (availableRules[j] != nullptr && availableRules[j + 1] != nullptr &&
-                maze->getNodeById(availableRules[j]->getTargetId())->getHeuristic() < maze->getNodeById(availableRules[j + 1]->getTargetId())->getHeuristic())
-            {
-                Edge *temp = availableRules[j];
-                availableRules[j] = availableRules[j + 1];
-                availableRules[j + 1] = temp;
-            }
-        }
+        distance = along;
+        return maze->getGoalId();
     }
 
-    // cout << "Ordered Rules: ";
-    // for (int i = 0; i < 4; i++)
-    // {
-    //     if (availableRules[i] != nullptr)
-    //     {
-    //       int target = availableRules[i]->getTargetId();
-    //       cout << target << ": " << maze->getNodeById(target)->getHeuristic() << endl;
-    //     }
-    // }
-    // cout << endl;
+    // Na vertical a linha não passa pelo objetivo; na horizontal, o salto vertical do nó na
+    // coluna dele só o alcança se o objetivo chega até a linha andando no sentido contrário
+    if (!isHorizontalDirection(direction) || goalReach[across > 0 ? 2 : 0] < abs(across))
+        return targetId;
+
+    distance = along;
+    targetId = mazeNodeId;
+    for (int i = 0; i < along; i++)
+        targetId = getNeighbourInDirection(maze, targetId, direction);
+    return targetId;
 }
 
-void pushInOpenedStack(Edge **availableRules, stack<TreeNode *> &abertos)
+// Caminho completo a partir dos pontos de salto: cada estado é alcançado do pai em linha reta
+// na direção usada, então os nós intermediários são refeitos andando nessa direção
+template <class Maze>
+stack<int> Tree::buildJumpSolution(Maze *maze, int state)
 {
-    for (int i = 0; i < 4; i++)
+    stack<int> pilha;
+    vector<int> segment;
+
+    while (state > 0)
     {
-        if (availableRules[i] != nullptr)
+        int direction = this->getUsedDirection(state);
+        int targetId = this->mazeIds[state];
+
+        segment.clear();
+        int mazeNodeId = this->mazeIds[this->parents[state]];
+        while (mazeNodeId != targetId && mazeNodeId >= 0)
         {
-            abertos.push(new TreeNode(availableRules[i]->getTargetId()));
+            mazeNodeId = getNeighbourInDirection(maze, mazeNodeId, direction);
+            segment.push_back(mazeNodeId);
         }
+
+        for (int i = (int)segment.size() - 1; i >= 0; i--)
+            pilha.push(segment[i]);
+
+        state = this->parents[state];
     }
+
+    if (state == 0)
+        pilha.push(this->mazeIds[0]);
+    return pilha;
 }
 
-void printStack(stack<TreeNode *> pilha)
+// A* sobre os pontos de salto (Jump Point Search para labirintos de 4 direções com custo
+// uniforme). Das regras aplicáveis ficam só as que a poda não descarta, e cada uma leva direto
+// ao próximo ponto de salto daquela direção; só os pontos de salto entram na árvore e nos
+// abertos, com custo igual ao número de passos
+template <class Maze, class OpenList>
+stack<int> Tree::jumpSearch(Maze *maze, OpenList &openList)
 {
-    cout << "Stack: ";
-    while (!pilha.empty())
-    {
-        TreeNode *node = pilha.top();
-        pilha.pop();
+    stack<int> pilha;
 
-        if (pilha.size() != 0)
+    if (maze->getNodeCount() == 0)
+        return pilha;
+
+    this->beginSearch(maze->getNodeCount());
+
+    // A tabela própria não sabe de qual labirinto veio, então só vale durante a busca
+    if (this->jumpTable == &this->ownJumpTable)
+        this->ownJumpTable.reset(maze->getNodeCount());
+    else
+        this->jumpTable->update(maze);
+
+    // Passos que o objetivo anda na vertical, para os saltos horizontais que cruzam a coluna dele
+    int goalReach[4] = {0, 0, 0, 0};
+    for (int direction = 0; direction < 4; direction += 2)
+    {
+        int mazeNodeId = getNeighbourInDirection(maze, maze->getGoalId(), direction);
+        for (int steps = maze->getNodeCount(); steps > 0 && mazeNodeId >= 0; steps--)
         {
-            cout << node->getId() << " -> ";
+            goalReach[direction]++;
+            mazeNodeId = getNeighbourInDirection(maze, mazeNodeId, direction);
         }
-        else
-            cout << node->getId() << " ";
     }
-    cout << " ___ " << endl;
-}
 
-stack<TreeNode *> Tree::greedySearch(Graph *maze)
-{
-    stack<TreeNode *> pilha;
+    int currentMazeNodeId = maze->getStartId();
 
-    if (maze->getFirstNode() == nullptr)
-        return pilha;
-
-    // pega id do primeiro nó do labirinto == estado inicial
-    Node *currentMazeNode = maze->getFirstNode();
-    TreeNode *currentState = new TreeNode(currentMazeNode->getId());
-    insertRoot(currentState);
+    int currentState = insertRoot(currentMazeNodeId);
+    this->setCost(currentState, 0);
+    this->setFScore(currentState, maze->getHeuristic(currentMazeNodeId));
+    this->context->setReached(currentMazeNodeId, 0, -1);
 
-    stack<TreeNode *> abertos;
+    openList.reset(maze->getNodeCount());
 
-    Edge *chosenEdge = nullptr;
+    Edge availableRules[4];
 
-    while (currentMazeNode->getTag() != "final")
+    while (!maze->isFinal(currentMazeNodeId))
     {
-        Edge **availableRules = getAvailableRules(currentMazeNode, currentState);
-        orderByHeuristic(availableRules, maze);
+        getAvailableRules(maze, this->context, this, currentMazeNodeId, currentState, availableRules);
 
-        currentState->setAvailableRules(availableRules);
+        this->setAvailableRules(currentState, availableRules);
 
         // nó puxou as regras, logo foi visitado
-        currentMazeNode->setVisited();
+        this->context->setVisited(currentMazeNodeId);
         this->visitedStatesNumber++;
 
+        int usedDirection = this->getUsedDirection(currentState);
+
         for (int i = 0; i < 4; i++)
         {
-
-            if (availableRules[i] != nullptr)
+            if (availableRules[i].isValid())
             {
-                chosenEdge = availableRules[i];
+                int direction = availableRules[i].getDirection();
+                if (!isJumpRule(maze, currentMazeNodeId, usedDirection, direction))
+                    continue;
 
-                // Cria novo nó cujo id é o nó destino daquela aresta no grafo
-                TreeNode *newTreeNode = new TreeNode(chosenEdge->getTargetId());
+                int distance;
+                int targetId = jump(maze, *this->jumpTable, goalReach, currentMazeNodeId, direction, distance);
 
-                // Insere novo nó na árvore
-                this->insert(currentState, newTreeNode, chosenEdge);
+                // Nenhum ponto de salto nessa direção
+                if (targetId < 0)
+                    continue;
 
-                // Remove aquela regra da lista de possíveis
-                availableRules[i] = nullptr;
+                double cost = this->getCost(currentState) + distance;
 
-                // Seta regras disponíveis daquele novo nó
-                currentState->setAvailableRules(availableRules);
+                if (this->context->getVisited(targetId) || cost >= this->context->getCost(targetId))
+                    continue;
 
-                // Marca a aresta utilizada para chegar até o novo nó
-                newTreeNode->setUsedEdge(chosenEdge);
+                // Aresta do salto, na direção da regra usada
+                Edge jumpEdge(currentMazeNodeId, targetId, distance);
+                jumpEdge.setDirection(direction);
 
-                // Troca nó atual do grafo de acordo com a aresta tomada
-                currentMazeNode = maze->getNodeById(chosenEdge->getTargetId());
+                int newState = this->insert(currentState, jumpEdge);
+                this->setCost(newState, cost);
+                this->context->setReached(targetId, cost, currentMazeNodeId);
+
+                double priority = cost + maze->getHeuristic(targetId);
+                this->setFScore(newState, priority);
 
-                abertos.push(newTreeNode);
+                if (openList.contains(targetId))
+                    openList.decrease(targetId, priority, newState);
+                else
+                    openList.push(targetId, priority, newState);
             }
         }
-        currentState = abertos.top();
-        abertos.pop();
-        currentMazeNode = maze->getNodeById(currentState->getId());
+
+        // Fronteira vazia: o objetivo não é alcançável
+        if (openList.isEmpty())
+            return pilha;
+
+        openList.pop(currentMazeNodeId, currentState);
     }
 
     // nó final
     this->visitedStatesNumber++;
 
-    currentState->setFinal();
+    this->setFinal(currentState);
 
-    // coloca todos os nós da busca solução em uma pilha
-    while (currentState != this->root)
+    // coloca todos os nós do caminho, inclusive os de dentro dos corredores, em uma pilha
+    return this->buildJumpSolution(maze, currentState);
+}
+
+// Labirinto que se declara uma grade de 4 vizinhos com custo 1 (isUniformGrid: GridMaze, e
+// Graph e MappedGraph montados de uma grade); quem não tem o método não é grade
+template <class Maze>
+auto isUniformGridMaze(Maze *maze, int) -> decltype(maze->isUniformGrid())
+{
+    return maze->isUniformGrid();
+}
+
+template <class Maze>
+bool isUniformGridMaze(Maze *, long)
+{
+    return false;
+}
+
+// A poda só vale em grades de 4 vizinhos com custo uniforme: com outras direções ou pesos 0 e
+// 1 misturados o salto devolveria caminhos mais caros. Nos outros labirintos a busca é o A*
+template <class Maze>
+stack<int> Tree::jumpPointSearch(Maze *maze)
+{
+    if (!isUniformGridMaze(maze, 0) || maze->getMaxIntegerWeight() != 1)
+        return this->aStarSearch(maze);
+    if (this->useBucketQueue(maze))
+        return this->jumpSearch(maze, this->bucketOpenList);
+    return this->jumpSearch(maze, this->heapOpenList);
+}
+
+// Estimativa até o início, heurística da metade do A* bidirecional que parte do objetivo (o
+// labirinto é não direcionado, então ela anda pelas mesmas arestas). Usa a mesma política do
+// getHeuristic do labirinto (MazeHeuristic)
+template <class Maze>
+double getReverseHeuristic(Maze *maze, int mazeNodeId)
+{
+    int startId = maze->getStartId();
+    return MazeHeuristic<Maze>::type::estimate(maze->getX(startId) - maze->getX(mazeNodeId),
+                                               maze->getY(startId) - maze->getY(mazeNodeId));
+}
+
+// Busca em largura a partir do início e do objetivo ao mesmo tempo. A cada passo um nível
+// inteiro da menor das duas fronteiras é expandido; quando um nó gerado já foi alcançado pela
+// outra metade, o caminho por ele é candidato. Ao final do nível em que houve encontro, o
+// candidato mais curto é o caminho com menos arestas. A árvore fica com duas raízes
+template <class Maze>
+stack<int> Tree::bidirectionalBreadthFirstSearch(Maze *maze)
+{
+    stack<int> pilha;
+
+    if (maze->getNodeCount() == 0 || maze->getGoalId() < 0)
+        return pilha;
+
+    this->beginSearch(maze->getNodeCount());
+    this->reverseContext.reset(maze->getNodeCount());
+
+    int startId = maze->getStartId();
+    int goalId = maze->getGoalId();
+
+    int startState = insertRoot(startId);
+    this->context->setReached(startId, 0, -1);
+
+    if (startId == goalId)
     {
-        pilha.push(currentState);
-        currentState = currentState->getFather();
+        this->visitedStatesNumber++;
+        this->setFinal(startState);
+        return this->buildSolution(startState);
     }
-    // add nó inicial
-    pilha.push(currentState);
 
-    // printStack(pilha);
+    int goalState = insertRoot(goalId);
+    this->reverseContext.setReached(goalId, 0, -1);
 
-    return pilha;
+    queue<int> abertos[2];
+    abertos[0].push(startState);
+    abertos[1].push(goalState);
+    SearchContext *contexts[2] = {this->context, &this->reverseContext};
+
+    int meetingMazeNodeId = -1;
+    double meetingCost = numeric_limits<double>::infinity();
+
+    Edge availableRules[4];
+
+    while (meetingMazeNodeId < 0)
+    {
+        // Fronteira vazia: o objetivo não é alcançável
+        if (abertos[0].empty() || abertos[1].empty())
+            return pilha;
+
+        int side = abertos[0].size() <= abertos[1].size() ? 0 : 1;
+        SearchContext *sideContext = contexts[side];
+        SearchContext *otherContext = contexts[1 - side];
+
+        for (size_t levelSize = abertos[side].size(); levelSize > 0; levelSize--)
+        {
+            int currentState = abertos[side].front();
+            abertos[side].pop();
+            int currentMazeNodeId = this->getMazeId(currentState);
+
+            getAvailableRules(maze, sideContext, this, currentMazeNodeId, currentState, availableRules);
+
+            this->setAvailableRules(currentState, availableRules);
+
+            // nó puxou as regras, logo foi visitado
+            sideContext->setVisited(currentMazeNodeId);
+            this->visitedStatesNumber++;
+
+            double depth = sideContext->getCost(currentMazeNodeId) + 1;
+
+            for (int i = 0; i < 4; i++)
+            {
+                if (!availableRules[i].isValid())
+                    continue;
+
+                int targetId = availableRules[i].getTargetId();
+                if (sideContext->isReached(targetId))
+                    continue;
+
+                sideContext->setReached(targetId, depth, currentMazeNodeId);
+                abertos[side].push(this->insert(currentState, availableRules[i]));
+
+                if (otherContext->isReached(targetId) && depth + otherContext->getCost(targetId) < meetingCost)
+                {
+                    meetingCost = depth + otherContext->getCost(targetId);
+                    meetingMazeNodeId = targetId;
+                }
+            }
+        }
+    }
+
+    this->setFinal(goalState);
+
+    return this->buildBidirectionalSolution(meetingMazeNodeId);
 }
 
-stack<TreeNode *> Tree::uniformCostSearch(Graph *maze)
+// A* bidirecional "front-to-end": cada metade usa a sua heurística (até o objetivo a partir do
+// início, até o início a partir do objetivo) e expande a metade com menos abertos. Todo
+// caminho melhor que o melhor já encontrado (custo mu) passa por um aberto de cada metade, e
+// a chave mínima de cada uma é um limite inferior para ele; a busca para quando uma delas
+// chega a mu. Usa sempre o heap indexado, que dá a chave mínima
+template <class Maze>
+stack<int> Tree::bidirectionalAStarSearch(Maze *maze)
 {
-    stack<TreeNode *> pilha;
+    stack<int> pilha;
 
-    if (maze->getFirstNode() == nullptr)
+    if (maze->getNodeCount() == 0 || maze->getGoalId() < 0)
         return pilha;
 
-    Node *currentMazeNode = maze->getFirstNode();
+    this->beginSearch(maze->getNodeCount());
+    this->reverseContext.reset(maze->getNodeCount());
+
+    int startId = maze->getStartId();
+    int goalId = maze->getGoalId();
 
-    TreeNode *currentState = new TreeNode(currentMazeNode->getId());
-    currentState->setCost(0); // Defina o custo inicial como 0
+    int startState = insertRoot(startId);
+    this->setFScore(startState, maze->getHeuristic(startId));
+    this->context->setReached(startId, 0, -1);
 
-    insertRoot(currentState);
+    if (startId == goalId)
+    {
+        this->visitedStatesNumber++;
+        this->setFinal(startState);
+        return this->buildSolution(startState);
+    }
+
+    int goalState = insertRoot(goalId);
+    this->setFScore(goalState, getReverseHeuristic(maze, goalId));
+    this->reverseContext.setReached(goalId, 0, -1);
 
-    priority_queue<TreeNode *, vector<TreeNode *>, CompareCost> abertos;
+    IndexedHeap *openLists[2] = {&this->heapOpenList, &this->reverseHeapOpenList};
+    SearchContext *contexts[2] = {this->context, &this->reverseContext};
+    openLists[0]->reset(maze->getNodeCount());
+    openLists[1]->reset(maze->getNodeCount());
+    openLists[0]->push(startId, this->getFScore(startState), startState);
+    openLists[1]->push(goalId, this->getFScore(goalState), goalState);
 
-    Edge *chosenEdge = nullptr;
+    int meetingMazeNodeId = -1;
+    double meetingCost = numeric_limits<double>::infinity();
 
-    while (currentMazeNode->getTag() != "final")
+    Edge availableRules[4];
+
+    while (!openLists[0]->isEmpty() && !openLists[1]->isEmpty())
     {
-        Edge **availableRules = getAvailableRules(currentMazeNode, currentState);
+        if (openLists[0]->getMinPriority() >= meetingCost || openLists[1]->getMinPriority() >= meetingCost)
+            break;
+
+        int side = openLists[0]->getSize() <= openLists[1]->getSize() ? 0 : 1;
+        SearchContext *sideContext = contexts[side];
+        SearchContext *otherContext = contexts[1 - side];
+
+        int currentMazeNodeId, currentState;
+        openLists[side]->pop(currentMazeNodeId, currentState);
 
-        currentState->setAvailableRules(availableRules);
+        getAvailableRules(maze, sideContext, this, currentMazeNodeId, currentState, availableRules);
+
+        this->setAvailableRules(currentState, availableRules);
 
         // nó puxou as regras, logo foi visitado
-        currentMazeNode->setVisited();
+        sideContext->setVisited(currentMazeNodeId);
         this->visitedStatesNumber++;
 
         for (int i = 0; i < 4; i++)
         {
-            if (availableRules[i] != nullptr)
-            {
-                chosenEdge = availableRules[i];
-
-                // Cria novo nó cujo id é o nó destino daquela aresta no grafo
-                TreeNode *newTreeNode = new TreeNode(chosenEdge->getTargetId());
+            if (!availableRules[i].isValid())
+                continue;
 
-                // Insere novo nó na árvore
-                this->insert(currentState, newTreeNode, chosenEdge);
+            int targetId = availableRules[i].getTargetId();
+            double cost = sideContext->getCost(currentMazeNodeId) + availableRules[i].getWeight();
 
-                // Remove aquela regra da lista de possíveis
-                availableRules[i] = nullptr;
-
-                // Seta regras disponíveis daquele novo nó
-                currentState->setAvailableRules(availableRules);
+            if (sideContext->getVisited(targetId) || cost >= sideContext->getCost(targetId))
+                continue;
 
-                // Marca a aresta utilizada para chegar até o novo nó
-                newTreeNode->setUsedEdge(chosenEdge);
+            int newState = this->insert(currentState, availableRules[i]);
+            this->setCost(newState, cost);
+            sideContext->setReached(targetId, cost, currentMazeNodeId);
 
-                // Atualiza o custo acumulado até este nó
-                newTreeNode->setCost(currentState->getCost() + chosenEdge->getWeight());
+            double priority = cost + (side == 0 ? maze->getHeuristic(targetId) : getReverseHeuristic(maze, targetId));
+            this->setFScore(newState, priority);
 
-                // Troca nó atual do grafo de acordo com a aresta tomada
-                currentMazeNode = maze->getNodeById(chosenEdge->getTargetId());
+            if (openLists[side]->contains(targetId))
+                openLists[side]->decrease(targetId, priority, newState);
+            else
+                openLists[side]->push(targetId, priority, newState);
 
-                abertos.push(newTreeNode);
+            if (cost + otherContext->getCost(targetId) < meetingCost)
+            {
+                meetingCost = cost + otherContext->getCost(targetId);
+                meetingMazeNodeId = targetId;
             }
         }
-        currentState = abertos.top();
-        abertos.pop();
-        currentMazeNode = maze->getNodeById(currentState->getId());
     }
 
-    // nó final
-    this->visitedStatesNumber++;
+    // Nenhum encontro: o objetivo não é alcançável
+    if (meetingMazeNodeId < 0)
+        return pilha;
 
-    currentState->setFinal();
+    this->setFinal(goalState);
 
-    // coloca todos os nós da busca solução em uma pilha
-    while (currentState != this->root)
+    return this->buildBidirectionalSolution(meetingMazeNodeId);
+}
+
+// IDA*: busca em profundidade limitada pelo custo f = g + h, repetida com o limite subindo
+// para o menor f que passou do limite anterior. Não usa o SearchContext nem abertos: a árvore
+// guarda só o caminho atual (cada estado com a máscara das regras que faltam tentar) e os nós
+// desse caminho ficam em um conjunto, para não andar em ciclos. A memória é proporcional ao
+// tamanho do caminho; o preço é reexpandir os nós a cada iteração.
+//
+// Com pesos inteiros o custo que falta até o objetivo também é inteiro, então a heurística
+// arredondada para cima continua admissível. Assim os limites são inteiros e cada iteração
+// sobe pelo menos 1, em vez de subir a cada valor fracionário da distância euclidiana
+template <class Maze>
+double getIterativeDeepeningHeuristic(Maze *maze, int mazeNodeId, bool integerCosts)
+{
+    double heuristic = maze->getHeuristic(mazeNodeId);
+    return integerCosts ? ceil(heuristic - 1e-9) : heuristic;
+}
+
+template <class Maze>
+stack<int> Tree::iterativeDeepeningAStarSearch(Maze *maze)
+{
+    stack<int> pilha;
+
+    if (maze->getNodeCount() == 0)
+        return pilha;
+
+    this->clearTree();
+    this->statesNumber = 0;
+    this->visitedStatesNumber = 0;
+
+    int startId = maze->getStartId();
+    bool integerCosts = maze->getMaxIntegerWeight() >= 0;
+    double threshold = getIterativeDeepeningHeuristic(maze, startId, integerCosts);
+    unordered_set<int> onPath;
+
+    Edge availableRules[4];
+
+    while (true)
     {
-        pilha.push(currentState);
-        currentState = currentState->getFather();
-    }
-    // add nó inicial
-    pilha.push(currentState);
+        this->clearTree();
+        int currentState = insertRoot(startId);
+        this->setFScore(currentState, threshold);
+        getAvailableRules(maze, nullptr, this, startId, currentState, availableRules);
+        this->setAvailableRules(currentState, availableRules);
+        onPath.clear();
+        onPath.insert(startId);
+        this->visitedStatesNumber++;
 
-    return pilha;
+        double nextThreshold = numeric_limits<double>::infinity();
+
+        while (currentState >= 0)
+        {
+            int currentMazeNodeId = this->getMazeId(currentState);
+
+            if (maze->isFinal(currentMazeNodeId))
+            {
+                this->setFinal(currentState);
+                return this->buildSolution(currentState);
+            }
+
+            // Regras que o estado ainda não tentou
+            getAvailableRules(maze, nullptr, this, currentMazeNodeId, currentState, availableRules);
+            int remaining = this->getAvailableRulesMask(currentState);
+            int i = 0;
+            while (i < 4 && !(availableRules[i].isValid() && ((remaining >> i) & 1)))
+                i++;
+
+            // Sem regras: volta para o pai
+            if (i == 4)
+            {
+                onPath.erase(currentMazeNodeId);
+                int parentState = this->getParent(currentState);
+                this->removeLastState();
+                currentState = parentState;
+                continue;
+            }
+
+            this->flags[currentState] &= (uint8_t)~(1 << (4 + i));
+
+            Edge chosenEdge = availableRules[i];
+            int targetId = chosenEdge.getTargetId();
+            double cost = this->getCost(currentState) + chosenEdge.getWeight();
+            double fScore = cost + getIterativeDeepeningHeuristic(maze, targetId, integerCosts);
+
+            // Passou do limite: candidato ao limite da próxima iteração
+            if (fScore > threshold)
+            {
+                nextThreshold = min(nextThreshold, fScore);
+                continue;
+            }
+
+            if (onPath.count(targetId))
+                continue;
+
+            int newState = this->insert(currentState, chosenEdge);
+            this->setCost(newState, cost);
+            this->setFScore(newState, fScore);
+            getAvailableRules(maze, nullptr, this, targetId, newState, availableRules);
+            this->setAvailableRules(newState, availableRules);
+            onPath.insert(targetId);
+            this->visitedStatesNumber++;
+
+            currentState = newState;
+        }
+
+        // Nenhum nó passou do limite: o objetivo não é alcançável
+        if (nextThreshold == numeric_limits<double>::infinity())
+            return pilha;
+
+        threshold = nextThreshold;
+    }
 }
 
-stack<TreeNode *> Tree::aStarSearch(Graph *maze)
+// A* anytime (ARA*): começa com a heurística multiplicada por um peso 3, que acha um caminho
+// depressa, e vai baixando o peso de 0,5 em 0,5 até 1 enquanto houver tempo (timeBudget).
+// Cada iteração reaproveita os custos da anterior: só os nós abertos e os que melhoraram
+// depois de fechados (inconsistentes) voltam para os abertos, com a nova prioridade g + peso * h.
+//
+// A primeira iteração sempre vai até o fim; depois dela a busca para quando o prazo acaba e
+// devolve o melhor caminho achado. O limite de subotimalidade é o menor entre o peso e o custo
+// do caminho dividido pelo menor g + h dos abertos e inconsistentes. Usa sempre o heap indexado
+template <class Maze>
+stack<int> Tree::anytimeAStarSearch(Maze *maze)
 {
-    stack<TreeNode *> pilha;
+    stack<int> pilha;
+
+    this->suboptimalityBound = numeric_limits<double>::infinity();
 
-    if (maze->getFirstNode() == nullptr)
+    if (maze->getNodeCount() == 0)
         return pilha;
 
-    Node *currentMazeNode = maze->getFirstNode();
+    Perf::PerformanceTimer clock;
+    clock.start();
+
+    this->beginSearch(maze->getNodeCount());
 
-    TreeNode *currentState = new TreeNode(currentMazeNode->getId());
-    currentState->setCost(0); // Defina o custo inicial como 0
-    currentState->setFScore(currentMazeNode->getHeuristic()); //Define fScore como 0 + heurística
-    insertRoot(currentState);
+    int startId = maze->getStartId();
+    int currentState = insertRoot(startId);
+    this->context->setReached(startId, 0, -1);
 
-    priority_queue<TreeNode *, vector<TreeNode *>, CompareFScore> abertos;
+    IndexedHeap &openList = this->heapOpenList;
+    openList.reset(maze->getNodeCount());
 
-    Edge *chosenEdge = nullptr;
+    // Nós fechados que melhoraram na iteração, com o estado do custo novo
+    vector<pair<int, int>> inconsistent;
+    vector<pair<int, int>> pending;
 
-    while (currentMazeNode->getTag() != "final")
+    double weight = 3;
+    double goalCost = numeric_limits<double>::infinity();
+    int goalState = -1;
+    if (maze->isFinal(startId))
     {
-        Edge **availableRules = getAvailableRules(currentMazeNode, currentState);
+        goalCost = 0;
+        goalState = currentState;
+    }
 
-        currentState->setAvailableRules(availableRules);
+    double priority = weight * maze->getHeuristic(startId);
+    this->setFScore(currentState, priority);
+    openList.push(startId, priority, currentState);
 
-        // nó puxou as regras, logo foi visitado
-        currentMazeNode->setVisited();
-        this->visitedStatesNumber++;
+    Edge availableRules[4];
 
-        for (int i = 0; i < 4; i++)
+    while (true)
+    {
+        bool timedOut = false;
+
+        // Melhora o caminho enquanto algum aberto pode levar a um custo menor
+        while (!openList.isEmpty() && goalCost > openList.getMinPriority())
         {
-            if (availableRules[i] != nullptr)
+            if (goalState >= 0 && (this->visitedStatesNumber & 255) == 0 && clock.elapsed_time() >= this->timeBudget)
             {
-                chosenEdge = availableRules[i];
+                timedOut = true;
+                break;
+            }
 
-                // Cria novo nó cujo id é o nó destino daquela aresta no grafo
-                TreeNode *newTreeNode = new TreeNode(chosenEdge->getTargetId());
+            int currentMazeNodeId;
+            openList.pop(currentMazeNodeId, currentState);
 
-                // Insere novo nó na árvore
-                this->insert(currentState, newTreeNode, chosenEdge);
+            getAvailableRules(maze, this->context, this, currentMazeNodeId, currentState, availableRules);
 
-                // Remove aquela regra da lista de possíveis
-                availableRules[i] = nullptr;
+            this->setAvailableRules(currentState, availableRules);
 
-                // Seta regras disponíveis daquele novo nó
-                currentState->setAvailableRules(availableRules);
+            // nó puxou as regras, logo foi visitado (fechado nesta iteração)
+            this->context->setVisited(currentMazeNodeId);
+            this->visitedStatesNumber++;
 
-                // Marca a aresta utilizada para chegar até o novo nó
-                newTreeNode->setUsedEdge(chosenEdge);
+            for (int i = 0; i < 4; i++)
+            {
+                if (!availableRules[i].isValid())
+                    continue;
 
-                // Atualiza o custo acumulado até este nó
-                newTreeNode->setCost(currentState->getCost() + chosenEdge->getWeight());
-                // Troca nó atual do grafo de acordo com a aresta tomada
-                currentMazeNode = maze->getNodeById(chosenEdge->getTargetId());
-                //Atualiza o valor de fScore
-                newTreeNode->setFScore(currentState->getCost() + currentMazeNode->getHeuristic());
+                int targetId = availableRules[i].getTargetId();
+                double cost = this->getCost(currentState) + availableRules[i].getWeight();
+                if (cost >= this->context->getCost(targetId))
+                    continue;
+
+                int newState = this->insert(currentState, availableRules[i]);
+                this->setCost(newState, cost);
+                this->context->setReached(targetId, cost, currentMazeNodeId);
 
-                abertos.push(newTreeNode);
+                if (maze->isFinal(targetId))
+                {
+                    goalCost = cost;
+                    goalState = newState;
+                }
+
+                if (this->context->getVisited(targetId))
+                {
+                    inconsistent.push_back({targetId, newState});
+                    continue;
+                }
+
+                priority = cost + weight * maze->getHeuristic(targetId);
+                this->setFScore(newState, priority);
+                if (openList.contains(targetId))
+                    openList.decrease(targetId, priority, newState);
+                else
+                    openList.push(targetId, priority, newState);
             }
         }
-        currentState = abertos.top();
-        abertos.pop();
-        currentMazeNode = maze->getNodeById(currentState->getId());
+
+        // Nenhum caminho: o objetivo não é alcançável
+        if (goalState < 0)
+            return pilha;
+
+        // Abertos e inconsistentes, sem as entradas de custos que já melhoraram de novo
+        pending.swap(inconsistent);
+        inconsistent.clear();
+        while (!openList.isEmpty())
+        {
+            int mazeNodeId, state;
+            openList.pop(mazeNodeId, state);
+            pending.push_back({mazeNodeId, state});
+        }
+
+        double minFScore = numeric_limits<double>::infinity();
+        for (pair<int, int> &entry : pending)
+            if (this->getCost(entry.second) == this->context->getCost(entry.first))
+                minFScore = min(minFScore, this->getCost(entry.second) + maze->getHeuristic(entry.first));
+
+        // O menor g + h é um limite inferior do custo ótimo; o peso só limita se a iteração
+        // terminou, e o limite anterior continua valendo porque o custo só diminui
+        double bound = minFScore > 0 ? max(1.0, goalCost / minFScore) : 1;
+        if (!timedOut)
+            bound = min(bound, weight);
+        this->suboptimalityBound = min(this->suboptimalityBound, bound);
+
+        if (timedOut || this->suboptimalityBound <= 1 || weight <= 1 || clock.elapsed_time() >= this->timeBudget)
+            break;
+
+        // Próxima iteração: peso menor, visitados limpos e abertos com a nova prioridade
+        weight = max(1.0, weight - 0.5);
+        this->context->clearVisited();
+        for (pair<int, int> &entry : pending)
+        {
+            int mazeNodeId = entry.first;
+            int state = entry.second;
+            if (this->getCost(state) != this->context->getCost(mazeNodeId) || openList.contains(mazeNodeId))
+                continue;
+
+            priority = this->getCost(state) + weight * maze->getHeuristic(mazeNodeId);
+            this->setFScore(state, priority);
+            openList.push(mazeNodeId, priority, state);
+        }
+        pending.clear();
     }
 
-    //nó final
-    this->visitedStatesNumber++;
+    this->setFinal(goalState);
 
-    // coloca todos os nós da busca solução em uma pilha
-    while (currentState != this->root)
+    // coloca todos os nós do melhor caminho achado em uma pilha
+    return this->buildSolution(goalState);
+}
+
+// Executa a busca pelo seu número no menu
+template <class Maze>
+stack<int> Tree::search(SearchAlgorithm algorithm, Maze *maze)
+{
+    // O A* anytime depende do prazo, então o resultado dele não é reaproveitado
+    bool useCache = this->pathCache != nullptr && algorithm != ANYTIME_A_STAR_SEARCH;
+    stack<int> solution;
+    if (useCache && this->pathCache->find(maze, algorithm, solution))
     {
-        pilha.push(currentState);
-        currentState = currentState->getFather();
+        this->beginSearch(maze->getNodeCount());
+        return solution;
     }
-    // add nó inicial
-    pilha.push(currentState);
 
-    return pilha;
+    switch (algorithm)
+    {
+    case BACKTRACKING_SEARCH:
+        solution = this->backtrackingSearch(maze);
+        break;
+    case BREADTH_FIRST_SEARCH:
+        solution = this->breadthFirstSearch(maze);
+        break;
+    case DEPTH_FIRST_SEARCH:
+        solution = this->depthFirstSearch(maze);
+        break;
+    case GREEDY_SEARCH:
+        solution = this->greedySearch(maze);
+        break;
+    case UNIFORM_COST_SEARCH:
+        solution = this->uniformCostSearch(maze);
+        break;
+    case A_STAR_SEARCH:
+        solution = this->aStarSearch(maze);
+        break;
+    case JUMP_POINT_SEARCH:
+        solution = this->jumpPointSearch(maze);
+        break;
+    case BIDIRECTIONAL_BREADTH_FIRST_SEARCH:
+        solution = this->bidirectionalBreadthFirstSearch(maze);
+        break;
+    case BIDIRECTIONAL_A_STAR_SEARCH:
+        solution = this->bidirectionalAStarSearch(maze);
+        break;
+    case ITERATIVE_DEEPENING_A_STAR_SEARCH:
+        solution = this->iterativeDeepeningAStarSearch(maze);
+        break;
+    case ANYTIME_A_STAR_SEARCH:
+        solution = this->anytimeAStarSearch(maze);
+        break;
+    default:
+        return solution;
+    }
+
+    if (useCache)
+        this->pathCache->insert(maze, algorithm, solution);
+    return solution;
 }
 
 #endif // TREE_H
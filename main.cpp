@@ -1,5 +1,15 @@
 #include "include/maze/Graph.h"
+#include "include/maze/MazeGenerator.h"
+#include "include/maze/MazeLoader.h"
+#include "include/maze/MappedGraph.h"
+#include "include/maze/CorridorMaze.h"
+#include "include/maze/ContractionHierarchy.h"
+#include "include/maze/LandmarkMaze.h"
+#include "include/maze/FlowFieldCache.h"
 #include "include/tree/Tree.h"
+#include "include/tree/LifelongPlanner.h"
+#include "include/batch/BatchEngine.h"
+#include "include/batch/ParallelBreadthFirstSearch.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -10,100 +20,76 @@
 
 using namespace std;
 
-string formatFloat(float value, int precision, int totalLength)
+// Escreve o valor com precision casas, alinhado à direita em totalLength colunas ("&" para FLT_MAX)
+void writeFloat(ostream &output, float value, int precision, int totalLength)
 {
-    string returnString = "";
+    output << setw(totalLength);
     if (value == FLT_MAX)
-        returnString = "&";
+        output << "&";
     else
-    {
-        std::stringstream stream;
-        stream << std::fixed << std::setprecision(precision) << value;
-        returnString = stream.str();
-    }
-    int missingSpaces = totalLength - returnString.length();
-    if (missingSpaces > 0)
-        returnString.insert(0, missingSpaces, ' ');
-    return returnString;
+        output << fixed << setprecision(precision) << value;
 }
 
-string exportGraphToDotFormat(Graph *graph, bool weighted)
+// Escreve o grafo no formato DOT direto no stream, nó a nó e aresta a aresta, sem montar o
+// texto inteiro em memória
+void writeGraphToDotFormat(Graph *graph, bool weighted, ostream &output)
 { // dot -Tpng output.dot -o graph1.png
     if (graph == nullptr)
-        return "";
-
-    Node *nextNode = graph->getFirstNode();
-    string dot = "", connector;
-    // bool weightedNode = graph->getWeightedNode();
-    // bool weightedEdge = graph->getWeightedEdge();
+        return;
 
-    dot += "strict ";
+    bool directed = false;
+    const char *connector = directed ? " -> " : " -- ";
 
-    if (false)
+    output << "strict " << (directed ? "di" : "") << "graph grafo {\n";
+    for (Node *nextNode = graph->getFirstNode(); nextNode != nullptr; nextNode = nextNode->getNextNode())
     {
-        connector = " -> ";
-        dot += "di";
-    }
-    else
-        connector = " -- ";
+        output << "  " << nextNode->getId() << " [weight = ";
+        writeFloat(output, nextNode->getId(), 2, 5);
+        output << ", pos = \"" << nextNode->getX() << "," << nextNode->getY() << "!\"";
 
-    dot += "graph grafo {\n";
-    char aspasDuplas = '"';
-    while (nextNode != nullptr)
-    {
-        dot += "  " + to_string(nextNode->getId()) +
-               " [weight = " + formatFloat(nextNode->getId(), 2, 5) +
-               ", pos = " + aspasDuplas + nextNode->getPosition() + "!" + aspasDuplas;
+        if (nextNode->getTag() == INITIAL_NODE)
+            output << ", color = red";
 
-        if (nextNode->getTag() == "inicial")
-            dot += ", color = red";
+        if (nextNode->getTag() == FINAL_NODE)
+            output << ", color = green";
 
-        if (nextNode->getTag() == "final")
-            dot += ", color = green";
-
-        dot += "];\n";
-
-        nextNode = nextNode->getNextNode();
+        output << "];\n";
     }
-    nextNode = graph->getFirstNode();
-    while (nextNode != nullptr)
+
+    for (Node *nextNode = graph->getFirstNode(); nextNode != nullptr; nextNode = nextNode->getNextNode())
     {
-        Edge *nextEdge = nextNode->getFirstEdge();
-        while ((nextEdge != nullptr))
+        for (Edge *nextEdge = nextNode->getFirstEdge(); nextEdge != nullptr; nextEdge = nextEdge->getNextEdge())
         {
-            if ((nextNode->getId() != graph->getNodeById(nextEdge->getTargetId())->getId()))
+            // Cada aresta é guardada nos dois sentidos, basta exportar um deles
+            if (nextNode->getId() < nextEdge->getTargetId())
             {
-                dot += "\n  " + to_string(nextNode->getId()) + connector +
-                       to_string(graph->getNodeById(nextEdge->getTargetId())->getId());
+                output << "\n  " << nextNode->getId() << connector << nextEdge->getTargetId();
                 if (weighted)
                 {
-                    dot += " [label = " + formatFloat(nextEdge->getWeight(), 1, 5) + ", fontsize = 10];";
+                    output << " [label = ";
+                    writeFloat(output, nextEdge->getWeight(), 1, 5);
+                    output << ", fontsize = 10];";
                 }
             }
-            nextEdge = nextEdge->getNextEdge();
         }
-        nextNode = nextNode->getNextNode();
     }
-    dot += "\n}\n";
-
-    return dot;
+    output << "\n}\n";
 }
 
-string exportTreeToDotFormat(Tree *tree)
+void writeTreeToDotFormat(Tree *tree, ostream &output)
 {
-    if (tree == nullptr || tree->getRoot() == nullptr)
-        return "";
+    if (tree == nullptr || tree->getRoot() < 0)
+        return;
 
-    TreeNode *rootNode = tree->getRoot();
-    string dot = "strict digraph tree {\nrankdir=TB;\n";
+    output << "strict digraph tree {\nrankdir=TB;\n";
 
-    // Traverse the tree and add nodes
-    tree->traverseAndPrint(rootNode, dot);
+    // Traverse the tree and add nodes (as buscas bidirecionais têm uma raiz em cada ponta)
+    for (int state = tree->getRoot(); state < tree->getSize(); state++)
+        if (tree->getParent(state) < 0)
+            tree->traverseAndPrint(state, output);
 
     // Close the graph
-    dot += "}\n";
-
-    return dot;
+    output << "}\n";
 }
 
 void writeOutputFile(Graph *graph, Tree *searchTree, int option, int menuOption)
@@ -116,21 +102,25 @@ void writeOutputFile(Graph *graph, Tree *searchTree, int option, int menuOption)
     else
         outputPath = "../images/dot/tree.dot";
 
-    // Abra o arquivo "output.dot" no caminho especificado e apague o conteúdo antigo
-    std::ofstream outputFile(outputPath, std::ios::trunc);
+    // Abra o arquivo "output.dot" no caminho especificado e apague o conteúdo antigo. O buffer
+    // de 1 MB precisa ser trocado antes de abrir o arquivo
+    vector<char> buffer(1 << 20);
+    std::ofstream outputFile;
+    outputFile.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    outputFile.open(outputPath, std::ios::trunc);
 
     if (outputFile.is_open())
     {
-        // Chame a função exportGraphToDotFormat e escreva o resultado no arquivo
+        // Escreve o grafo ou a árvore direto no arquivo
         if (option == 0)
         {
-            if (menuOption == 5 || menuOption ==6)
-                outputFile << exportGraphToDotFormat(graph, true);
+            if (menuOption == 5 || menuOption ==6 || menuOption == 7 || menuOption >= 9)
+                writeGraphToDotFormat(graph, true, outputFile);
             else
-                outputFile << exportGraphToDotFormat(graph, false);
+                writeGraphToDotFormat(graph, false, outputFile);
         }
         else
-            outputFile << exportTreeToDotFormat(searchTree);
+            writeTreeToDotFormat(searchTree, outputFile);
 
         // Feche o arquivo
         outputFile.close();
@@ -141,22 +131,22 @@ void writeOutputFile(Graph *graph, Tree *searchTree, int option, int menuOption)
     }
 }
 
-void printSolution(stack<TreeNode *> pilha, string search, Perf::PerformanceTimer clock, int statesNumber, int visitedStatesNumber)
+void printSolution(stack<int> pilha, string search, Perf::PerformanceTimer clock, int statesNumber, int visitedStatesNumber)
 {
     stringstream formattedTime;
 
     cout << search + "Solution: ";
     while (!pilha.empty())
     {
-        TreeNode *node = pilha.top();
+        int id = pilha.top();
         pilha.pop();
 
         if (pilha.size() != 0)
         {
-            cout << node->getId() << " -> ";
+            cout << id << " -> ";
         }
         else
-            cout << node->getId() << " ";
+            cout << id << " ";
     }
     cout << " ENDED " << endl;
 
@@ -174,47 +164,143 @@ void printSolution(stack<TreeNode *> pilha, string search, Perf::PerformanceTime
     cout << "Estados visitados: " << visitedStatesNumber << " estados" << endl;
 }
 
-int main(int argc, char const *argv[])
+void printUsage()
 {
+    cout << "Uso: ./main [--generate <backtracker|kruskal|wilson|braid> <largura> <altura> <semente>]" << endl
+         << "            [--load <arquivo>]" << endl
+         << "            [... --save <arquivo.bin>]" << endl
+         << "            [... --batch <consultas> <threads> <busca 1-11>]" << endl
+         << "            [... --benchmark-open-list <consultas>]" << endl
+         << "            [... --parallel-bfs <threads>]" << endl
+         << "            [... --contract]" << endl
+         << "            [... --contraction-hierarchy <consultas> <arquivo.ch>]" << endl
+         << "            [... --landmarks <marcos> <consultas>]" << endl
+         << "            [... --flow-field <agentes>]" << endl
+         << "            [... --replan <mudanças>]" << endl
+         << "            [... --path-cache <consultas> <MB>]" << endl
+         << "            [... --heuristics <consultas>]" << endl;
+}
 
-    Graph *maze = new Graph();
-    maze->generateMaze();
+// Monta o labirinto pedido na linha de comando; sem argumentos usa o labirinto fixo.
+// Arquivos binários não são copiados para o Graph: a busca roda direto no mapeamento.
+bool buildMaze(Graph *maze, MappedGraph **mappedMaze, int argc, char const *argv[])
+{
+    if (argc == 1)
+    {
+        maze->generateMaze();
+        return true;
+    }
 
-    Tree *searchTree = new Tree();
-    std::stack<TreeNode *> solution;
+    if (strcmp(argv[1], "--generate") == 0 && argc == 6)
+    {
+        MazeAlgorithm algorithm;
+        if (!MazeGenerator::parseAlgorithm(argv[2], algorithm))
+            return false;
 
-    // clock
-    Perf::PerformanceTimer clock;
+        int width = atoi(argv[3]);
+        int height = atoi(argv[4]);
+        if (width <= 0 || height <= 0)
+            return false;
 
-    // aux var
-    int statesNumber = 0;
-    int visitedStatesNumber = 0;
+        MazeGenerator generator(strtoull(argv[5], nullptr, 10));
+        GridMaze *grid = generator.generate(algorithm, width, height);
 
-    int option = -1;
+        cout << "Labirinto gerado: " << (long long)width * height << " células em "
+             << fixed << setprecision(3) << generator.getElapsedTime() * 1000 << " milisegundos ("
+             << setprecision(0) << generator.getCellsPerSecond() << " células/s)" << endl;
+        cout.unsetf(ios::floatfield);
 
-    std::cout << "+---------------------------+" << std::endl
-              << "|   PROBLEMA DO LABIRINTO   |" << std::endl
-              << "|      MÉTODOS DE BUSCA     |" << std::endl
-              << "+---------------------------+" << std::endl
-              << "|    Selecione a busca:     |" << std::endl
-              << "|                           |" << std::endl
-              << "| [1] Busca backtracking    |" << std::endl
-              << "| [2] Busca em largura      |" << std::endl
-              << "| [3] Busca em profundidade |" << std::endl
-              << "| [4] Busca gulosa          |" << std::endl
-              << "| [5] Busca ordenada        |" << std::endl
-              << "| [6] Busca A*              |" << std::endl
-              << "|                           |" << std::endl
-              << "| [0] Sair                  |" << std::endl
-              << "+---------------------------+" << std::endl;
+        maze->insertGrid(grid);
+        delete grid;
+        return true;
+    }
 
-    while (option < 0 || option > 6)
+    if (strcmp(argv[1], "--load") == 0 && argc == 3)
     {
-        std::cout << "  Digite sua opção: ";
-        std::cin >> option;
-        std::cout << endl;
+        Perf::PerformanceTimer timer;
+        timer.start();
+
+        if (MappedGraph::isMazeFile(argv[2]))
+        {
+            MappedGraph *mapped = new MappedGraph(argv[2]);
+            timer.stop();
+            if (!mapped->isOpen())
+            {
+                delete mapped;
+                return false;
+            }
+
+            cout << "Labirinto mapeado: " << mapped->getNodeCount() << " nós em "
+                 << fixed << setprecision(3) << timer.elapsed_time() * 1000 << " milisegundos" << endl;
+            cout.unsetf(ios::floatfield);
+            *mappedMaze = mapped;
+            return true;
+        }
+
+        if (MazeLoader::isEdgeList(argv[2]))
+        {
+            if (!MazeLoader::loadEdgeList(argv[2], maze))
+                return false;
+        }
+        else
+        {
+            GridMaze *grid = MazeLoader::loadAsciiGrid(argv[2]);
+            if (grid == nullptr)
+                return false;
+            maze->insertGrid(grid);
+            delete grid;
+        }
+
+        timer.stop();
+        cout << "Labirinto carregado: " << maze->getNodeCount() << " nós em "
+             << fixed << setprecision(3) << timer.elapsed_time() * 1000 << " milisegundos" << endl;
+        cout.unsetf(ios::floatfield);
+        return true;
     }
 
+    return false;
+}
+
+// Caminho nó a nó no labirinto original; só o labirinto de corredores contraídos precisa refazer
+template <class Maze>
+stack<int> expandSolution(Maze *, stack<int> solution)
+{
+    return solution;
+}
+
+template <class Maze>
+stack<int> expandSolution(CorridorMaze<Maze> *maze, stack<int> solution)
+{
+    return maze->expandPath(solution);
+}
+
+// Contrai os corredores do labirinto e imprime quanto o grafo de busca diminuiu
+template <class Maze>
+CorridorMaze<Maze> *contractMaze(Maze *maze)
+{
+    CorridorMaze<Maze> *corridorMaze = new CorridorMaze<Maze>(maze);
+
+    cout << "Corredores contraídos: " << corridorMaze->getNodeCount() << " de " << corridorMaze->getCellCount()
+         << " nós, " << corridorMaze->getEdgeCount() << " arestas" << fixed << setprecision(1) << " ("
+         << (double)corridorMaze->getCellCount() / max(1, corridorMaze->getNodeCount()) << "x menor, "
+         << setprecision(3) << corridorMaze->getElapsedTime() * 1000 << " milisegundos)" << endl;
+    cout.unsetf(ios::floatfield);
+    return corridorMaze;
+}
+
+// Executa a busca escolhida no menu sobre qualquer labirinto com a interface de busca
+template <class Maze>
+void runSearch(Maze *maze, Tree *searchTree, int option)
+{
+    std::stack<int> solution;
+
+    // clock
+    Perf::PerformanceTimer clock;
+
+    // aux var
+    int statesNumber = 0;
+    int visitedStatesNumber = 0;
+
     switch (option)
     {
 
@@ -224,7 +310,7 @@ int main(int argc, char const *argv[])
         clock.stop();
         statesNumber = searchTree->getStatesNumber();
         visitedStatesNumber = searchTree->getVisitedStatesNumber();
-        printSolution(solution, "Backtracking Search", clock, statesNumber, visitedStatesNumber);
+        printSolution(expandSolution(maze, solution), "Backtracking Search", clock, statesNumber, visitedStatesNumber);
         break;
 
     case 2:
@@ -233,7 +319,7 @@ int main(int argc, char const *argv[])
         clock.stop();
         statesNumber = searchTree->getStatesNumber();
         visitedStatesNumber = searchTree->getVisitedStatesNumber();
-        printSolution(solution, "Breadth-First Search", clock, statesNumber, visitedStatesNumber);
+        printSolution(expandSolution(maze, solution), "Breadth-First Search", clock, statesNumber, visitedStatesNumber);
         break;
 
     case 3:
@@ -242,7 +328,7 @@ int main(int argc, char const *argv[])
         clock.stop();
         statesNumber = searchTree->getStatesNumber();
         visitedStatesNumber = searchTree->getVisitedStatesNumber();
-        printSolution(solution, "Depth-First Search", clock, statesNumber, visitedStatesNumber);
+        printSolution(expandSolution(maze, solution), "Depth-First Search", clock, statesNumber, visitedStatesNumber);
         break;
 
     case 4:
@@ -251,7 +337,7 @@ int main(int argc, char const *argv[])
         clock.stop();
         statesNumber = searchTree->getStatesNumber();
         visitedStatesNumber = searchTree->getVisitedStatesNumber();
-        printSolution(solution, "Greedy Search", clock, statesNumber, visitedStatesNumber);
+        printSolution(expandSolution(maze, solution), "Greedy Search", clock, statesNumber, visitedStatesNumber);
         break;
 
     case 5:
@@ -260,7 +346,7 @@ int main(int argc, char const *argv[])
         clock.stop();
         statesNumber = searchTree->getStatesNumber();
         visitedStatesNumber = searchTree->getVisitedStatesNumber();
-        printSolution(solution, "Uniform Cost Search", clock, statesNumber, visitedStatesNumber);
+        printSolution(expandSolution(maze, solution), "Uniform Cost Search", clock, statesNumber, visitedStatesNumber);
         break;
 
     case 6:
@@ -269,19 +355,779 @@ int main(int argc, char const *argv[])
         clock.stop();
         statesNumber = searchTree->getStatesNumber();
         visitedStatesNumber = searchTree->getVisitedStatesNumber();
-        printSolution(solution, "A-Star Search", clock, statesNumber, visitedStatesNumber);
+        printSolution(expandSolution(maze, solution), "A-Star Search", clock, statesNumber, visitedStatesNumber);
+        break;
+
+    case 7:
+        clock.start();
+        solution = searchTree->jumpPointSearch(maze);
+        clock.stop();
+        statesNumber = searchTree->getStatesNumber();
+        visitedStatesNumber = searchTree->getVisitedStatesNumber();
+        printSolution(expandSolution(maze, solution), "Jump Point Search", clock, statesNumber, visitedStatesNumber);
+        break;
+
+    case 8:
+        clock.start();
+        solution = searchTree->bidirectionalBreadthFirstSearch(maze);
+        clock.stop();
+        statesNumber = searchTree->getStatesNumber();
+        visitedStatesNumber = searchTree->getVisitedStatesNumber();
+        printSolution(expandSolution(maze, solution), "Bidirectional Breadth-First Search", clock, statesNumber, visitedStatesNumber);
+        break;
+
+    case 9:
+        clock.start();
+        solution = searchTree->bidirectionalAStarSearch(maze);
+        clock.stop();
+        statesNumber = searchTree->getStatesNumber();
+        visitedStatesNumber = searchTree->getVisitedStatesNumber();
+        printSolution(expandSolution(maze, solution), "Bidirectional A-Star Search", clock, statesNumber, visitedStatesNumber);
+        break;
+
+    case 10:
+        clock.start();
+        solution = searchTree->iterativeDeepeningAStarSearch(maze);
+        clock.stop();
+        statesNumber = searchTree->getStatesNumber();
+        visitedStatesNumber = searchTree->getVisitedStatesNumber();
+        printSolution(expandSolution(maze, solution), "Iterative Deepening A-Star Search", clock, statesNumber, visitedStatesNumber);
+        break;
+
+    case 11:
+        clock.start();
+        solution = searchTree->anytimeAStarSearch(maze);
+        clock.stop();
+        statesNumber = searchTree->getStatesNumber();
+        visitedStatesNumber = searchTree->getVisitedStatesNumber();
+        printSolution(expandSolution(maze, solution), "Anytime A-Star Search", clock, statesNumber, visitedStatesNumber);
+        cout << fixed << setprecision(3) << "Limite de subotimalidade: " << searchTree->getSuboptimalityBound()
+             << " (prazo de " << searchTree->getTimeBudget() * 1000 << " milisegundos)" << endl;
+        cout.unsetf(ios::floatfield);
         break;
 
     default:
         break;
     }
 
-    // OPÇÃO 0 - CONVERTE GRAFO
-    writeOutputFile(maze, searchTree, 0, option);
+}
+
+// Roda um lote de consultas sorteadas e imprime vazão e latências
+template <class Maze>
+void runBatch(Maze *maze, int queryCount, int threadCount, int option)
+{
+    BatchEngine<Maze> engine(maze, threadCount);
+    engine.addRandomQueries(queryCount, (SearchAlgorithm)option, 1);
+    engine.run();
+
+    cout << "Lote: " << engine.getQueryCount() << " consultas em " << engine.getThreadCount() << " threads, "
+         << engine.getFoundCount() << " com caminho" << endl;
+    cout << fixed << setprecision(3)
+         << "Tempo: " << engine.getElapsedTime() * 1000 << " milisegundos" << endl
+         << "Vazão: " << setprecision(0) << engine.getQueriesPerSecond() << " consultas/s" << endl
+         << setprecision(6)
+         << "Latência p50: " << engine.getLatencyPercentile(0.50) * 1000 << " milisegundos" << endl
+         << "Latência p99: " << engine.getLatencyPercentile(0.99) * 1000 << " milisegundos" << endl;
+    cout.unsetf(ios::floatfield);
+}
+
+// Compara o heap indexado com a fila de baldes nas mesmas consultas da busca ordenada e do A*
+template <class Maze>
+void runOpenListBenchmark(Maze *maze, int queryCount)
+{
+    if (maze->getMaxIntegerWeight() < 0)
+        cout << "Pesos não inteiros: a fila de baldes não se aplica a este labirinto" << endl;
+
+    SearchAlgorithm algorithms[2] = {UNIFORM_COST_SEARCH, A_STAR_SEARCH};
+    string algorithmNames[2] = {"Busca ordenada", "Busca A*"};
+    OpenListType openLists[2] = {HEAP_OPEN_LIST, BUCKET_OPEN_LIST};
+    string openListNames[2] = {"heap", "baldes"};
+
+    for (int a = 0; a < 2; a++)
+    {
+        for (int l = 0; l < 2; l++)
+        {
+            if (openLists[l] == BUCKET_OPEN_LIST && maze->getMaxIntegerWeight() < 0)
+                continue;
+
+            BatchEngine<Maze> engine(maze, 1);
+            engine.setOpenListType(openLists[l]);
+            engine.addRandomQueries(queryCount, algorithms[a], 1);
+            engine.run();
+
+            cout << algorithmNames[a] << " (" << openListNames[l] << "): " << fixed << setprecision(3)
+                 << engine.getElapsedTime() * 1000 << " milisegundos, " << setprecision(0)
+                 << engine.getQueriesPerSecond() << " consultas/s, p50 " << setprecision(6)
+                 << engine.getLatencyPercentile(0.50) * 1000 << " milisegundos" << endl;
+            cout.unsetf(ios::floatfield);
+        }
+    }
+}
+
+// Busca em largura do início até todos os nós, serial e com threadCount threads, conferindo
+// que as duas dão as mesmas distâncias e pais
+template <class Maze>
+void runParallelBreadthFirstSearch(Maze *maze, int threadCount)
+{
+    ParallelBreadthFirstSearch<Maze> serial(maze, 1);
+    ParallelBreadthFirstSearch<Maze> parallel(maze, threadCount);
+    serial.run(maze->getStartId());
+    parallel.run(maze->getStartId());
+
+    int differences = 0;
+    for (int id = 0; id < maze->getNodeCount(); id++)
+        if (serial.getDistance(id) != parallel.getDistance(id) || serial.getParent(id) != parallel.getParent(id))
+            differences++;
+
+    cout << "Largura para todos os nós: " << serial.getReachedCount() << " alcançados, " << serial.getLevelCount()
+         << " níveis (" << serial.getBottomUpLevelCount() << " de baixo para cima)" << endl;
+    cout << fixed << setprecision(3)
+         << "Serial: " << serial.getElapsedTime() * 1000 << " milisegundos" << endl
+         << parallel.getThreadCount() << " threads: " << parallel.getElapsedTime() * 1000 << " milisegundos" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << (differences == 0 ? "Distâncias e pais iguais" : "Distâncias ou pais diferentes em " + to_string(differences) + " nós") << endl;
+}
+
+// Responde consultas sorteadas com a hierarquia de contração e com a busca ordenada, conferindo
+// os custos. A hierarquia é lida de path se ela for deste labirinto; se não, é montada e gravada
+template <class Maze>
+void runContractionHierarchy(Maze *maze, int queryCount, const char *path)
+{
+    ContractionHierarchy hierarchy;
+    if (hierarchy.load(path, maze))
+        cout << "Hierarquia lida de " << path << endl;
+    else
+    {
+        hierarchy.build(maze);
+        cout << fixed << setprecision(3) << "Hierarquia montada em " << hierarchy.getElapsedTime() * 1000
+             << " milisegundos" << endl;
+        cout.unsetf(ios::floatfield);
+        if (hierarchy.save(path))
+            cout << "Hierarquia salva em " << path << endl;
+        else
+            cerr << "Erro ao salvar a hierarquia em " << path << endl;
+    }
+
+    cout << hierarchy.getShortcutCount() << " atalhos, " << hierarchy.getEdgeCount() << " arestas para cima, "
+         << fixed << setprecision(1) << hierarchy.getMemoryUsage() / (1024.0 * 1024.0) << " MB ("
+         << (double)hierarchy.getEdgeCount() / max(1, maze->getEdgeCount()) << " arestas por aresta do labirinto)" << endl;
+    cout.unsetf(ios::floatfield);
+
+    int nodeCount = maze->getNodeCount();
+    if (nodeCount <= 0)
+        return;
+
+    Tree tree;
+    Perf::PerformanceTimer clock;
+    double hierarchyTime = 0;
+    double searchTime = 0;
+    int differences = 0;
+    mt19937_64 rng(1);
+    for (int i = 0; i < queryCount; i++)
+    {
+        int startId = (int)(rng() % nodeCount);
+        int goalId = (int)(rng() % nodeCount);
+        QueryMaze<Maze> queryMaze(maze, startId, goalId);
+
+        clock.start();
+        stack<int> solution = tree.uniformCostSearch(&queryMaze);
+        clock.stop();
+        searchTime += clock.elapsed_time();
+        double searchDistance = solution.empty() ? numeric_limits<double>::infinity()
+                                                 : tree.getSearchContext()->getCost(goalId);
+
+        clock.start();
+        hierarchy.findPath(startId, goalId);
+        clock.stop();
+        hierarchyTime += clock.elapsed_time();
+
+        if (hierarchy.getDistance() != searchDistance &&
+            fabs(hierarchy.getDistance() - searchDistance) > 1e-9 * max(1.0, searchDistance))
+            differences++;
+    }
+
+    cout << fixed << setprecision(6)
+         << "Busca ordenada: " << searchTime * 1000 / queryCount << " milisegundos por consulta" << endl
+         << "Hierarquia: " << hierarchyTime * 1000 / queryCount << " milisegundos por consulta ("
+         << setprecision(1) << searchTime / max(hierarchyTime, 1e-12) << "x mais rápida)" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << (differences == 0 ? "Custos iguais" : "Custos diferentes em " + to_string(differences) + " consultas") << endl;
+}
+
+// Compara o A* com a heurística euclidiana e com a heurística ALT nas mesmas consultas sorteadas
+template <class Maze>
+void runLandmarkBenchmark(Maze *maze, int landmarkCount, int queryCount)
+{
+    LandmarkTable table;
+    table.build(maze, landmarkCount);
+    cout << table.getLandmarkCount() << " marcos em " << fixed << setprecision(3) << table.getElapsedTime() * 1000
+         << " milisegundos, " << setprecision(1) << table.getMemoryUsage() / (1024.0 * 1024.0) << " MB" << endl;
+    cout.unsetf(ios::floatfield);
+
+    int nodeCount = maze->getNodeCount();
+    if (nodeCount <= 0)
+        return;
+
+    Tree tree;
+    Perf::PerformanceTimer clock;
+    double elapsedTimes[2] = {0, 0};
+    long long visitedStates[2] = {0, 0};
+    int differences = 0;
+    mt19937_64 rng(1);
+    for (int i = 0; i < queryCount; i++)
+    {
+        int startId = (int)(rng() % nodeCount);
+        int goalId = (int)(rng() % nodeCount);
+        QueryMaze<Maze> queryMaze(maze, startId, goalId);
+        LandmarkMaze<Maze> landmarkMaze(maze, &table, startId, goalId);
+
+        clock.start();
+        stack<int> solution = tree.aStarSearch(&queryMaze);
+        clock.stop();
+        elapsedTimes[0] += clock.elapsed_time();
+        visitedStates[0] += tree.getVisitedStatesNumber();
+        double euclideanCost = solution.empty() ? -1 : tree.getSearchContext()->getCost(goalId);
+
+        clock.start();
+        solution = tree.aStarSearch(&landmarkMaze);
+        clock.stop();
+        elapsedTimes[1] += clock.elapsed_time();
+        visitedStates[1] += tree.getVisitedStatesNumber();
+        double landmarkCost = solution.empty() ? -1 : tree.getSearchContext()->getCost(goalId);
+
+        if (fabs(euclideanCost - landmarkCost) > 1e-9 * max(1.0, euclideanCost))
+            differences++;
+    }
+
+    string names[2] = {"A* euclidiano", "A* com marcos (ALT)"};
+    for (int h = 0; h < 2; h++)
+    {
+        cout << names[h] << ": " << visitedStates[h] / queryCount << " estados visitados, " << fixed << setprecision(6)
+             << elapsedTimes[h] * 1000 / queryCount << " milisegundos por consulta" << endl;
+        cout.unsetf(ios::floatfield);
+    }
+    cout << (differences == 0 ? "Custos iguais" : "Custos diferentes em " + to_string(differences) + " consultas") << endl;
+}
+
+// Leva agentes de inícios sorteados até o objetivo do labirinto pelo campo de fluxo e, para
+// comparar, com um A* por agente
+template <class Maze>
+void runFlowField(Maze *maze, int agentCount)
+{
+    int nodeCount = maze->getNodeCount();
+    int goalId = maze->getGoalId();
+    if (nodeCount <= 0 || goalId < 0)
+    {
+        cout << "O labirinto não tem objetivo" << endl;
+        return;
+    }
+
+    FlowFieldCache<Maze> cache(maze, 1);
+    Tree tree;
+    Perf::PerformanceTimer clock;
+    double fieldTime = 0;
+    double searchTime = 0;
+    int differences = 0;
+    mt19937_64 rng(1);
+    for (int i = 0; i < agentCount; i++)
+    {
+        int startId = (int)(rng() % nodeCount);
+
+        clock.start();
+        FlowField *field = cache.getField(goalId);
+        stack<int> path = field->followPath(maze, startId);
+        clock.stop();
+        fieldTime += clock.elapsed_time();
+        double fieldCost = path.empty() ? -1 : field->getDistance(startId);
+
+        QueryMaze<Maze> queryMaze(maze, startId, goalId);
+        clock.start();
+        stack<int> solution = tree.aStarSearch(&queryMaze);
+        clock.stop();
+        searchTime += clock.elapsed_time();
+        double searchCost = solution.empty() ? -1 : tree.getSearchContext()->getCost(goalId);
+
+        if (fabs(fieldCost - searchCost) > 1e-6 * max(1.0, searchCost))
+            differences++;
+    }
+
+    cout << cache.getBuildCount() << " campo(s) calculado(s), " << cache.getHitCount() << " reaproveitado(s)" << endl;
+
+    FlowField *field = cache.getField(goalId);
+    cout << "Campo de fluxo até " << goalId << " em " << fixed << setprecision(3) << field->getElapsedTime() * 1000
+         << " milisegundos, " << setprecision(1) << field->getMemoryUsage() / (1024.0 * 1024.0) << " MB" << endl
+         << setprecision(6)
+         << "Campo de fluxo: " << fieldTime * 1000 / agentCount << " milisegundos por agente (com o cálculo do campo)" << endl
+         << "A*: " << searchTime * 1000 / agentCount << " milisegundos por agente" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << (differences == 0 ? "Custos iguais" : "Custos diferentes em " + to_string(differences) + " agentes") << endl;
+}
+
+// Abre e fecha portas no caminho atual e compara o replanejamento incremental (LPA*) com um A*
+// do zero depois de cada mudança: uma mudança fecha uma aresta do caminho, a seguinte reabre
+// a porta fechada há mais tempo
+template <class Maze>
+void runReplanning(Maze *maze, int changeCount)
+{
+    LifelongPlanner planner;
+    planner.build(maze);
+    stack<int> path = planner.findPath();
+    cout << "Planejamento inicial: " << planner.getExpandedCount() << " nós expandidos" << endl;
+
+    Tree tree;
+    Perf::PerformanceTimer clock;
+    long long expanded[2] = {0, 0};
+    double elapsedTimes[2] = {0, 0};
+    int differences = 0;
+    queue<Edge> closedEdges;
+    mt19937_64 rng(1);
+    for (int change = 0; change < changeCount; change++)
+    {
+        if (change % 2 == 0 && path.size() >= 2)
+        {
+            vector<int> nodes;
+            for (; !path.empty(); path.pop())
+                nodes.push_back(path.top());
+            int index = (int)(rng() % (nodes.size() - 1));
+
+            Edge edges[4];
+            int numEdges = planner.getEdges(nodes[index], edges);
+            for (int i = 0; i < numEdges; i++)
+                if (edges[i].getTargetId() == nodes[index + 1])
+                    closedEdges.push(edges[i]);
+            planner.removeEdge(nodes[index], nodes[index + 1]);
+        }
+        else if (!closedEdges.empty())
+        {
+            Edge &edge = closedEdges.front();
+            planner.insertEdge(edge.getSourceId(), edge.getTargetId(), edge.getDirection(), edge.getWeight());
+            closedEdges.pop();
+        }
+
+        path = planner.findPath();
+        expanded[0] += planner.getExpandedCount();
+        elapsedTimes[0] += planner.getElapsedTime();
+
+        clock.start();
+        stack<int> solution = tree.aStarSearch(&planner);
+        clock.stop();
+        expanded[1] += tree.getVisitedStatesNumber();
+        elapsedTimes[1] += clock.elapsed_time();
+
+        double searchCost = solution.empty() ? numeric_limits<double>::infinity()
+                                             : tree.getSearchContext()->getCost(planner.getGoalId());
+        if (planner.getCost() != searchCost && fabs(planner.getCost() - searchCost) > 1e-9 * max(1.0, searchCost))
+            differences++;
+    }
+
+    string names[2] = {"LPA*", "A* do zero"};
+    for (int i = 0; i < 2; i++)
+    {
+        cout << names[i] << ": " << expanded[i] / max(1, changeCount) << " nós expandidos por mudança, " << fixed
+             << setprecision(6) << elapsedTimes[i] * 1000 / max(1, changeCount) << " milisegundos" << endl;
+        cout.unsetf(ios::floatfield);
+    }
+    cout << (differences == 0 ? "Custos iguais" : "Custos diferentes em " + to_string(differences) + " mudanças") << endl;
+}
+
+// Repete consultas A* sorteadas de um conjunto pequeno de pares, com e sem o cache de
+// caminhos na frente da busca, e confere se os caminhos são os mesmos
+template <class Maze>
+void runPathCache(Maze *maze, int queryCount, double megabytes)
+{
+    int nodeCount = maze->getNodeCount();
+    if (nodeCount <= 0)
+        return;
+
+    // Um par distinto para cada 10 consultas, em média
+    mt19937_64 rng(1);
+    vector<pair<int, int>> pairs(max(1, queryCount / 10));
+    for (pair<int, int> &query : pairs)
+        query = {(int)(rng() % nodeCount), (int)(rng() % nodeCount)};
+
+    PathCache cache((size_t)(megabytes * 1024 * 1024));
+    Tree cachedTree;
+    cachedTree.setPathCache(&cache);
+    Tree tree;
+    Perf::PerformanceTimer clock;
+    double elapsedTimes[2] = {0, 0};
+    int differences = 0;
+    for (int i = 0; i < queryCount; i++)
+    {
+        pair<int, int> &query = pairs[rng() % pairs.size()];
+        QueryMaze<Maze> queryMaze(maze, query.first, query.second);
+
+        clock.start();
+        stack<int> cachedSolution = cachedTree.search(A_STAR_SEARCH, &queryMaze);
+        clock.stop();
+        elapsedTimes[0] += clock.elapsed_time();
+
+        clock.start();
+        stack<int> solution = tree.search(A_STAR_SEARCH, &queryMaze);
+        clock.stop();
+        elapsedTimes[1] += clock.elapsed_time();
+
+        if (cachedSolution != solution)
+            differences++;
+    }
+
+    cout << "Cache de caminhos: " << cache.getHitCount() << " acertos, " << cache.getMissCount() << " falhas, "
+         << cache.getEvictionCount() << " descartes, " << cache.getEntryCount() << " caminhos em " << fixed
+         << setprecision(1) << cache.getMemoryUsage() / 1024.0 << " KB" << endl
+         << setprecision(6)
+         << "A* com cache: " << elapsedTimes[0] * 1000 / queryCount << " milisegundos por consulta" << endl
+         << "A* sem cache: " << elapsedTimes[1] * 1000 / queryCount << " milisegundos por consulta" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << (differences == 0 ? "Caminhos iguais" : "Caminhos diferentes em " + to_string(differences) + " consultas") << endl;
+}
+
+// Roda o A* com a política Heuristic nas consultas e imprime estados visitados e tempo; custos
+// recebe o custo de cada consulta (-1 sem caminho)
+template <class Heuristic, class Maze>
+void runHeuristicQueries(Maze *maze, string name, vector<pair<int, int>> &queries, vector<double> &costs)
+{
+    Tree tree;
+    Perf::PerformanceTimer clock;
+    double elapsedTime = 0;
+    long long visitedStates = 0;
+    costs.assign(queries.size(), -1);
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        QueryMaze<Maze, Heuristic> queryMaze(maze, queries[i].first, queries[i].second);
+
+        clock.start();
+        stack<int> solution = tree.aStarSearch(&queryMaze);
+        clock.stop();
+        elapsedTime += clock.elapsed_time();
+        visitedStates += tree.getVisitedStatesNumber();
+        if (!solution.empty())
+            costs[i] = tree.getSearchContext()->getCost(queries[i].second);
+    }
+
+    cout << name << ": " << visitedStates / (long long)queries.size() << " estados visitados, " << fixed << setprecision(6)
+         << elapsedTime * 1000 / queries.size() << " milisegundos por consulta" << endl;
+    cout.unsetf(ios::floatfield);
+}
+
+// Compara as heurísticas no A* em pares de início e objetivo sorteados; a heurística zero (busca
+// de custo uniforme) dá os custos ótimos, e as outras são conferidas contra ela
+template <class Maze>
+void runHeuristicBenchmark(Maze *maze, int queryCount)
+{
+    int nodeCount = maze->getNodeCount();
+    if (nodeCount <= 0)
+        return;
+
+    mt19937_64 rng(1);
+    vector<pair<int, int>> queries(queryCount);
+    for (pair<int, int> &query : queries)
+        query = {(int)(rng() % nodeCount), (int)(rng() % nodeCount)};
+
+    vector<double> referenceCosts;
+    vector<double> costs[3];
+    runHeuristicQueries<ZeroHeuristic>(maze, "Zero", queries, referenceCosts);
+    runHeuristicQueries<EuclideanHeuristic>(maze, "Euclidiana", queries, costs[0]);
+    runHeuristicQueries<ManhattanHeuristic>(maze, "Manhattan", queries, costs[1]);
+    runHeuristicQueries<OctileHeuristic>(maze, "Octile", queries, costs[2]);
+
+    string names[3] = {"Euclidiana", "Manhattan", "Octile"};
+    for (int h = 0; h < 3; h++)
+    {
+        int differences = 0;
+        for (int i = 0; i < queryCount; i++)
+            if (fabs(costs[h][i] - referenceCosts[i]) > 1e-9 * max(1.0, referenceCosts[i]))
+                differences++;
+        cout << names[h] << ": "
+             << (differences == 0 ? "custos ótimos" : "custos acima do ótimo em " + to_string(differences) + " consultas")
+             << endl;
+    }
+}
+
+// Opções de comparação e de lote lidas da linha de comando (ver main)
+struct ComparisonOptions
+{
+    const char *savePath = nullptr;
+    int heuristicQueries = 0;
+    int cacheQueries = 0;
+    double cacheMegabytes = 0;
+    int replanChanges = 0;
+    int flowFieldAgents = 0;
+    int landmarkCount = 0;
+    int landmarkQueries = 0;
+    const char *hierarchyPath = nullptr;
+    int hierarchyQueries = 0;
+    bool contract = false;
+    int benchmarkQueries = 0;
+    int parallelBfsThreads = -1;
+    int batchQueries = 0;
+    int batchThreads = 0;
+    int batchOption = 0;
+};
+
+// Roda as comparações pedidas e o lote sobre o labirinto montado (Graph ou MappedGraph); com
+// --contract o lote busca no labirinto com os corredores contraídos
+template <class Maze>
+void runComparisons(Maze *maze, ComparisonOptions &options)
+{
+    if (options.benchmarkQueries > 0)
+        runOpenListBenchmark(maze, options.benchmarkQueries);
+
+    if (options.parallelBfsThreads >= 0)
+        runParallelBreadthFirstSearch(maze, options.parallelBfsThreads);
+
+    if (options.hierarchyQueries > 0)
+        runContractionHierarchy(maze, options.hierarchyQueries, options.hierarchyPath);
+
+    if (options.landmarkQueries > 0)
+        runLandmarkBenchmark(maze, options.landmarkCount, options.landmarkQueries);
+
+    if (options.flowFieldAgents > 0)
+        runFlowField(maze, options.flowFieldAgents);
+
+    if (options.replanChanges > 0)
+        runReplanning(maze, options.replanChanges);
+
+    if (options.cacheQueries > 0)
+        runPathCache(maze, options.cacheQueries, options.cacheMegabytes);
+
+    if (options.heuristicQueries > 0)
+        runHeuristicBenchmark(maze, options.heuristicQueries);
+
+    if (options.batchQueries > 0)
+    {
+        CorridorMaze<Maze> *corridorMaze = options.contract ? contractMaze(maze) : nullptr;
+        if (corridorMaze != nullptr)
+            runBatch(corridorMaze, options.batchQueries, options.batchThreads, options.batchOption);
+        else
+            runBatch(maze, options.batchQueries, options.batchThreads, options.batchOption);
+        delete corridorMaze;
+    }
+}
+
+// Mostra o menu e roda a busca escolhida no labirinto (com os corredores contraídos se
+// contract); devolve a opção escolhida
+template <class Maze>
+int runSearchMenu(Maze *maze, bool contract, Tree *searchTree)
+{
+    CorridorMaze<Maze> *corridorMaze = contract ? contractMaze(maze) : nullptr;
+
+    int option = -1;
+
+    std::cout << "+---------------------------+" << std::endl
+              << "|   PROBLEMA DO LABIRINTO   |" << std::endl
+              << "|      MÉTODOS DE BUSCA     |" << std::endl
+              << "+---------------------------+" << std::endl
+              << "|    Selecione a busca:     |" << std::endl
+              << "|                           |" << std::endl
+              << "| [1] Busca backtracking    |" << std::endl
+              << "| [2] Busca em largura      |" << std::endl
+              << "| [3] Busca em profundidade |" << std::endl
+              << "| [4] Busca gulosa          |" << std::endl
+              << "| [5] Busca ordenada        |" << std::endl
+              << "| [6] Busca A*              |" << std::endl
+              << "| [7] Busca JPS (saltos)    |" << std::endl
+              << "| [8] Largura bidirecional  |" << std::endl
+              << "| [9] A* bidirecional       |" << std::endl
+              << "| [10] Busca IDA*           |" << std::endl
+              << "| [11] A* anytime (ARA*)    |" << std::endl
+              << "|                           |" << std::endl
+              << "| [0] Sair                  |" << std::endl
+              << "+---------------------------+" << std::endl;
+
+    while (option < 0 || option > 11)
+    {
+        std::cout << "  Digite sua opção: ";
+        std::cin >> option;
+        std::cout << endl;
+    }
+
+    if (corridorMaze != nullptr)
+        runSearch(corridorMaze, searchTree, option);
+    else
+        runSearch(maze, searchTree, option);
+
+    delete corridorMaze;
+    return option;
+}
+
+int main(int argc, char const *argv[])
+{
+    // Opções finais: --save <arquivo> grava o labirinto montado no formato binário e
+    // --batch <consultas> <threads> <busca> roda um lote de consultas no lugar do menu;
+    // --benchmark-open-list <consultas> compara as listas de abertos da busca ordenada e do A*;
+    // --parallel-bfs <threads> roda a busca em largura até todos os nós, serial e paralela;
+    // --contract faz o menu e o lote buscarem no labirinto com os corredores contraídos;
+    // --contraction-hierarchy <consultas> <arquivo> compara a hierarquia com a busca ordenada;
+    // --landmarks <marcos> <consultas> compara o A* euclidiano com o A* com marcos (ALT);
+    // --flow-field <agentes> leva agentes até o objetivo pelo campo de fluxo;
+    // --replan <mudanças> compara o replanejamento incremental com o A* do zero;
+    // --path-cache <consultas> <MB> repete consultas com o cache de caminhos na frente do A*;
+    // --heuristics <consultas> compara as heurísticas euclidiana, Manhattan, octile e zero no A*
+    ComparisonOptions options;
+    int mazeArgc = argc;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+        {
+            options.savePath = argv[i + 1];
+            mazeArgc = min(mazeArgc, i);
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--batch") == 0 && i + 3 < argc)
+        {
+            options.batchQueries = atoi(argv[i + 1]);
+            options.batchThreads = atoi(argv[i + 2]);
+            options.batchOption = atoi(argv[i + 3]);
+            if (options.batchQueries <= 0 || options.batchOption < 1 || options.batchOption > 11)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 3;
+        }
+        else if (strcmp(argv[i], "--benchmark-open-list") == 0 && i + 1 < argc)
+        {
+            options.benchmarkQueries = atoi(argv[i + 1]);
+            if (options.benchmarkQueries <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--parallel-bfs") == 0 && i + 1 < argc)
+        {
+            options.parallelBfsThreads = atoi(argv[i + 1]);
+            mazeArgc = min(mazeArgc, i);
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--contraction-hierarchy") == 0 && i + 2 < argc)
+        {
+            options.hierarchyQueries = atoi(argv[i + 1]);
+            options.hierarchyPath = argv[i + 2];
+            if (options.hierarchyQueries <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 2;
+        }
+        else if (strcmp(argv[i], "--landmarks") == 0 && i + 2 < argc)
+        {
+            options.landmarkCount = atoi(argv[i + 1]);
+            options.landmarkQueries = atoi(argv[i + 2]);
+            if (options.landmarkCount <= 0 || options.landmarkQueries <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 2;
+        }
+        else if (strcmp(argv[i], "--flow-field") == 0 && i + 1 < argc)
+        {
+            options.flowFieldAgents = atoi(argv[i + 1]);
+            if (options.flowFieldAgents <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--replan") == 0 && i + 1 < argc)
+        {
+            options.replanChanges = atoi(argv[i + 1]);
+            if (options.replanChanges <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--path-cache") == 0 && i + 2 < argc)
+        {
+            options.cacheQueries = atoi(argv[i + 1]);
+            options.cacheMegabytes = atof(argv[i + 2]);
+            if (options.cacheQueries <= 0 || options.cacheMegabytes <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 2;
+        }
+        else if (strcmp(argv[i], "--heuristics") == 0 && i + 1 < argc)
+        {
+            options.heuristicQueries = atoi(argv[i + 1]);
+            if (options.heuristicQueries <= 0)
+            {
+                printUsage();
+                return 1;
+            }
+            mazeArgc = min(mazeArgc, i);
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--contract") == 0)
+        {
+            options.contract = true;
+            mazeArgc = min(mazeArgc, i);
+        }
+    }
+    argc = mazeArgc;
+
+    Graph *maze = new Graph();
+    MappedGraph *mappedMaze = nullptr;
+    if (!buildMaze(maze, &mappedMaze, argc, argv))
+    {
+        printUsage();
+        delete maze;
+        return 1;
+    }
+
+    if (options.savePath != nullptr && mappedMaze == nullptr)
+    {
+        if (MappedGraph::save(maze, options.savePath))
+            cout << "Labirinto salvo em " << options.savePath << endl;
+        else
+            cerr << "Erro ao salvar o labirinto em " << options.savePath << endl;
+    }
+
+    if (mappedMaze != nullptr)
+        runComparisons(mappedMaze, options);
+    else
+        runComparisons(maze, options);
+
+    // Sem nenhuma das opções de comparação, o programa segue para o menu de buscas
+    bool runMenu = options.benchmarkQueries == 0 && options.batchQueries == 0 && options.parallelBfsThreads < 0 &&
+                   options.hierarchyQueries == 0 && options.landmarkQueries == 0 && options.flowFieldAgents == 0 &&
+                   options.replanChanges == 0 && options.cacheQueries == 0 && options.heuristicQueries == 0;
+    if (!runMenu)
+    {
+        delete maze;
+        delete mappedMaze;
+        return 0;
+    }
+
+    Tree *searchTree = new Tree();
+    int option;
+    if (mappedMaze != nullptr)
+        option = runSearchMenu(mappedMaze, options.contract, searchTree);
+    else
+        option = runSearchMenu(maze, options.contract, searchTree);
+
+    // OPÇÃO 0 - CONVERTE GRAFO (o grafo mapeado não é exportado)
+    if (mappedMaze == nullptr)
+        writeOutputFile(maze, searchTree, 0, option);
     // OPÇÃO 1 - CONVERTE ÁRVORE
     writeOutputFile(maze, searchTree, 1, option);
 
     delete maze;
+    delete mappedMaze;
     delete searchTree;
 
     return 0;